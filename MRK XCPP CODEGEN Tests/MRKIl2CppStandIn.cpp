@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKIl2CppStandIn.h"
+#include "MRKModule.h"
+#include "MRKXCPPStructs.h"
+#include "MRKXCPPBackendIl2Cpp.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace MRK {
+	MRKStandIn ms_StandIn;
+	int ms_StandInDomain;
+
+	MRKStandIn& MRKStandInGet() {
+		return ms_StandIn;
+	}
+
+	MRKStandInImage* MRKStandIn::AddImage(const char* name) {
+		Images.push_back({ name, {} });
+		Assemblies.push_back(&Images.back());
+		return &Images.back();
+	}
+
+	MRKStandInClass* MRKStandIn::AddClass(MRKStandInImage* image, const char* namespaze, const char* name, const char* typeName,
+		int flags, MRKStandInClass* parent, bool valueType) {
+		Classes.push_back({});
+
+		MRKStandInClass* clazz = &Classes.back();
+		clazz->Namespace = namespaze;
+		clazz->Name = name;
+		clazz->Flags = flags;
+		clazz->Token = 0x02000001 + (mrku32)image->Classes.size();
+		clazz->Image = image;
+		clazz->Parent = parent;
+		clazz->Type = { valueType ? MRK_TYPE_VALUETYPE : MRK_TYPE_CLASS, typeName, clazz };
+		clazz->ValueType = valueType;
+
+		image->Classes.push_back(clazz);
+		return clazz;
+	}
+
+	MRKStandInType* MRKStandIn::AddType(int kind, const char* name, MRKStandInClass* clazz) {
+		//generic instances always have a class of their own, a reference type unless given one
+		if (kind == MRK_TYPE_GENERICINST && !clazz) {
+			Classes.push_back({});
+
+			clazz = &Classes.back();
+			clazz->Namespace = "";
+			clazz->Name = name;
+			clazz->Type = { kind, name, clazz };
+		}
+
+		Types.push_back({ kind, name, clazz });
+		return &Types.back();
+	}
+
+	MRKStandInType* MRKStandIn::AddArray(MRKStandInClass* element, const char* name) {
+		Classes.push_back({});
+
+		MRKStandInClass* clazz = &Classes.back();
+		clazz->Namespace = element->Namespace;
+		clazz->Name = name;
+		clazz->Image = element->Image;
+		clazz->Type = { MRK_TYPE_SZARRAY, name, clazz };
+		clazz->Element = element;
+
+		return AddType(MRK_TYPE_SZARRAY, name, clazz);
+	}
+
+	MRKStandInField* MRKStandIn::AddField(MRKStandInClass* clazz, const char* name, int flags, MRKStandInType* type, size_t offset) {
+		Fields.push_back({ name, flags, type, offset });
+		clazz->Fields.push_back(&Fields.back());
+		return &Fields.back();
+	}
+
+	MRKStandInMethod* MRKStandIn::AddMethod(MRKStandInClass* clazz, const char* name, mrku32 flags, mrku32 token,
+		MRKStandInType* returnType, mrks vector<MRKStandInType*> params, bool generic) {
+		Methods.push_back({ name, flags, 0, token, generic, clazz, returnType, params });
+		clazz->Methods.push_back(&Methods.back());
+		return &Methods.back();
+	}
+
+	//iterators hold the index of the next element plus one, 0 starts over
+	template<typename T>
+	void* MRKStandInNext(mrks vector<T*>& items, void** iter) {
+		size_t idx = (size_t)*iter;
+		if (idx >= items.size())
+			return 0;
+
+		*iter = (void*)(idx + 1);
+		return items[idx];
+	}
+
+	//one definition per export, declared from the list so a prototype drifting from the backend's fails to link
+#define X(ret, name, params) ret MRKStandIn_##name params;
+	MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+
+	void* MRKStandIn_il2cpp_domain_get() {
+		return &ms_StandInDomain;
+	}
+
+	void* MRKStandIn_il2cpp_thread_attach(void* domain) {
+		return domain;
+	}
+
+	void** MRKStandIn_il2cpp_domain_get_assemblies(void* domain, size_t* size) {
+		*size = ms_StandIn.Assemblies.size();
+		return ms_StandIn.Assemblies.data();
+	}
+
+	void* MRKStandIn_il2cpp_assembly_get_image(void* assembly) {
+		return assembly;
+	}
+
+	const char* MRKStandIn_il2cpp_image_get_name(void* image) {
+		return ((MRKStandInImage*)image)->Name;
+	}
+
+	size_t MRKStandIn_il2cpp_image_get_class_count(void* image) {
+		return ((MRKStandInImage*)image)->Classes.size();
+	}
+
+	void* MRKStandIn_il2cpp_image_get_class(void* image, size_t index) {
+		mrks vector<MRKStandInClass*>& classes = ((MRKStandInImage*)image)->Classes;
+		return index < classes.size() ? classes[index] : 0;
+	}
+
+	void* MRKStandIn_il2cpp_class_from_name(void* image, const char* namespaze, const char* name) {
+		for (MRKStandInClass* clazz : ((MRKStandInImage*)image)->Classes) {
+			if (!strcmp(clazz->Namespace, namespaze) && !strcmp(clazz->Name, name))
+				return clazz;
+		}
+
+		return 0;
+	}
+
+	void* MRKStandIn_il2cpp_class_from_type(void* type) {
+		return ((MRKStandInType*)type)->Class;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_type(void* clazz) {
+		return &((MRKStandInClass*)clazz)->Type;
+	}
+
+	mrku32 MRKStandIn_il2cpp_class_get_type_token(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Token;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_parent(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Parent;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_image(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Image;
+	}
+
+	const char* MRKStandIn_il2cpp_class_get_name(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Name;
+	}
+
+	const char* MRKStandIn_il2cpp_class_get_namespace(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Namespace;
+	}
+
+	int MRKStandIn_il2cpp_class_get_flags(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Flags;
+	}
+
+	bool MRKStandIn_il2cpp_class_is_enum(void* clazz) {
+		return ((MRKStandInClass*)clazz)->EnumBase != 0;
+	}
+
+	bool MRKStandIn_il2cpp_class_is_valuetype(void* clazz) {
+		return ((MRKStandInClass*)clazz)->ValueType;
+	}
+
+	void* MRKStandIn_il2cpp_class_enum_basetype(void* clazz) {
+		return ((MRKStandInClass*)clazz)->EnumBase;
+	}
+
+	int MRKStandIn_il2cpp_class_value_size(void* clazz, mrku32* align) {
+		if (align)
+			*align = 0;
+
+		return ((MRKStandInClass*)clazz)->ValueSize;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_element_class(void* clazz) {
+		return ((MRKStandInClass*)clazz)->Element;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_fields(void* clazz, void** iter) {
+		return MRKStandInNext(((MRKStandInClass*)clazz)->Fields, iter);
+	}
+
+	//name lookups walk up the parents, the way il2cpp's do
+	void* MRKStandIn_il2cpp_class_get_field_from_name(void* clazz, const char* name) {
+		for (MRKStandInClass* current = (MRKStandInClass*)clazz; current; current = current->Parent) {
+			for (MRKStandInField* field : current->Fields) {
+				if (!strcmp(field->Name, name))
+					return field;
+			}
+		}
+
+		return 0;
+	}
+
+	void* MRKStandIn_il2cpp_class_get_methods(void* clazz, void** iter) {
+		return MRKStandInNext(((MRKStandInClass*)clazz)->Methods, iter);
+	}
+
+	void* MRKStandIn_il2cpp_class_get_method_from_name(void* clazz, const char* name, int argc) {
+		for (MRKStandInClass* current = (MRKStandInClass*)clazz; current; current = current->Parent) {
+			for (MRKStandInMethod* method : current->Methods) {
+				if (!strcmp(method->Name, name) && (argc == -1 || method->Params.size() == (size_t)argc))
+					return method;
+			}
+		}
+
+		return 0;
+	}
+
+	const char* MRKStandIn_il2cpp_field_get_name(void* field) {
+		return ((MRKStandInField*)field)->Name;
+	}
+
+	int MRKStandIn_il2cpp_field_get_flags(void* field) {
+		return ((MRKStandInField*)field)->Flags;
+	}
+
+	void* MRKStandIn_il2cpp_field_get_type(void* field) {
+		return ((MRKStandInField*)field)->Type;
+	}
+
+	size_t MRKStandIn_il2cpp_field_get_offset(void* field) {
+		return ((MRKStandInField*)field)->Offset;
+	}
+
+	const char* MRKStandIn_il2cpp_method_get_name(void* method) {
+		return ((MRKStandInMethod*)method)->Name;
+	}
+
+	mrku32 MRKStandIn_il2cpp_method_get_param_count(void* method) {
+		return (mrku32)((MRKStandInMethod*)method)->Params.size();
+	}
+
+	void* MRKStandIn_il2cpp_method_get_param(void* method, mrku32 index) {
+		mrks vector<MRKStandInType*>& params = ((MRKStandInMethod*)method)->Params;
+		return index < params.size() ? params[index] : 0;
+	}
+
+	void* MRKStandIn_il2cpp_method_get_return_type(void* method) {
+		return ((MRKStandInMethod*)method)->ReturnType;
+	}
+
+	mrku32 MRKStandIn_il2cpp_method_get_flags(void* method, mrku32* iflags) {
+		if (iflags)
+			*iflags = ((MRKStandInMethod*)method)->ImplFlags;
+
+		return ((MRKStandInMethod*)method)->Flags;
+	}
+
+	mrku32 MRKStandIn_il2cpp_method_get_token(void* method) {
+		return ((MRKStandInMethod*)method)->Token;
+	}
+
+	bool MRKStandIn_il2cpp_method_is_generic(void* method) {
+		return ((MRKStandInMethod*)method)->Generic;
+	}
+
+	void* MRKStandIn_il2cpp_method_get_class(void* method) {
+		return ((MRKStandInMethod*)method)->Class;
+	}
+
+	//il2cpp hands out a copy the caller frees through il2cpp_free
+	char* MRKStandIn_il2cpp_type_get_name(void* type) {
+		const char* name = ((MRKStandInType*)type)->Name;
+		size_t len = strlen(name) + 1;
+		return (char*)memcpy(malloc(len), name, len);
+	}
+
+	int MRKStandIn_il2cpp_type_get_type(void* type) {
+		return ((MRKStandInType*)type)->Kind;
+	}
+
+	void MRKStandIn_il2cpp_free(void* ptr) {
+		free(ptr);
+	}
+
+	struct MRKStandInExport {
+		const char* Name;
+		void* Ptr;
+	};
+
+	MRKStandInExport ms_StandInExports[] = {
+#define X(ret, name, params) { #name, (void*)&MRKStandIn_##name },
+		MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+	};
+
+	mrku32 MRKStandInGetExportCount() {
+		return sizeof(ms_StandInExports) / sizeof(ms_StandInExports[0]);
+	}
+
+	//replaces MRKModule.cpp, only the il2cpp module is "loaded"
+	void* MRKModuleOpen(const char* name) {
+		return !strcmp(name, IL2CPP_MODULE_NAME) ? ms_StandInExports : 0;
+	}
+
+	void* MRKModuleGetSymbol(void* module, const char* sym) {
+		if (module != ms_StandInExports)
+			return 0;
+
+		for (MRKStandInExport& exp : ms_StandInExports) {
+			if (!strcmp(exp.Name, sym))
+				return exp.Ptr;
+		}
+
+		return 0;
+	}
+
+	mrks string MRKModuleGetHostPath() {
+		return "";
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "MRKCommon.h"
+
+//in-memory il2cpp runtime: the exports of MRK_IL2CPP_FUNCTIONS over a hand-built metadata graph.
+//it stands in for GameAssembly through MRKModuleOpen/MRKModuleGetSymbol, the backend runs unchanged against it
+namespace MRK {
+	struct MRKStandInClass;
+
+	struct MRKStandInType {
+		int Kind;
+		const char* Name; //as il2cpp_type_get_name prints it, "System.Collections.Generic.List`1<T>"
+		MRKStandInClass* Class;
+	};
+
+	struct MRKStandInField {
+		const char* Name;
+		int Flags;
+		MRKStandInType* Type;
+		size_t Offset;
+	};
+
+	struct MRKStandInMethod {
+		const char* Name;
+		mrku32 Flags;
+		mrku32 ImplFlags;
+		mrku32 Token;
+		bool Generic;
+		MRKStandInClass* Class;
+		MRKStandInType* ReturnType;
+		mrks vector<MRKStandInType*> Params;
+	};
+
+	struct MRKStandInImage {
+		const char* Name;
+		mrks vector<MRKStandInClass*> Classes;
+	};
+
+	struct MRKStandInClass {
+		const char* Namespace;
+		const char* Name;
+		int Flags;
+		mrku32 Token;
+		MRKStandInImage* Image;
+		MRKStandInClass* Parent;
+		MRKStandInType Type;
+		bool ValueType;
+		int ValueSize;
+		MRKStandInClass* Element; //arrays
+		MRKStandInType* EnumBase; //enums
+		mrks vector<MRKStandInField*> Fields;
+		mrks vector<MRKStandInMethod*> Methods;
+	};
+
+	//everything the exports see, node addresses stay stable as it grows
+	struct MRKStandIn {
+		mrks deque<MRKStandInImage> Images;
+		mrks deque<MRKStandInClass> Classes;
+		mrks deque<MRKStandInType> Types;
+		mrks deque<MRKStandInField> Fields;
+		mrks deque<MRKStandInMethod> Methods;
+		mrks vector<void*> Assemblies; //one per image, the image itself stands for its assembly
+
+		MRKStandInImage* AddImage(const char* name);
+		MRKStandInClass* AddClass(MRKStandInImage* image, const char* namespaze, const char* name, const char* typeName,
+			int flags, MRKStandInClass* parent = 0, bool valueType = false);
+		MRKStandInType* AddType(int kind, const char* name, MRKStandInClass* clazz = 0);
+		MRKStandInType* AddArray(MRKStandInClass* element, const char* name); //T[], listed in no image
+		MRKStandInField* AddField(MRKStandInClass* clazz, const char* name, int flags, MRKStandInType* type, size_t offset);
+		MRKStandInMethod* AddMethod(MRKStandInClass* clazz, const char* name, mrku32 flags, mrku32 token,
+			MRKStandInType* returnType, mrks vector<MRKStandInType*> params = {}, bool generic = false);
+	};
+
+	MRKStandIn& MRKStandInGet();
+	mrku32 MRKStandInGetExportCount();
+}
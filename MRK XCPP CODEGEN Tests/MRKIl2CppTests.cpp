@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//runs the IL2CPP backend against MRKIl2CppStandIn, built by the MRK XCPP CODEGEN Tests project or with the backend sources and without MRKModule.cpp:
+//g++ -std=c++17 -I"../MRK XCPP CODEGEN" *.cpp ../MRK\ XCPP\ CODEGEN/{MRKXCPPBackend,MRKXCPPBackendIl2Cpp,MRKXCPPBackendMono,MRKXCPPNames,MRKLog}.cpp
+
+#include "MRKIl2CppStandIn.h"
+#include "MRKXCPPBackend.h"
+#include "MRKXCPPBackendIl2Cpp.h"
+#include "MRKAlloc.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define MRK_CHECK(cond) MRK::MRKCheck(cond, #cond, __LINE__)
+#define MRK_CHECK_STR(a, b) MRK::MRKCheck((a) && !strcmp(a, b), #a " == " #b, __LINE__)
+
+namespace MRK {
+	mrku32 ms_Checks;
+	mrku32 ms_Failures;
+
+	void MRKCheck(bool ok, const char* expr, int line) {
+		ms_Checks++;
+		if (ok)
+			return;
+
+		ms_Failures++;
+		printf("FAILED line %d: %s\n", line, expr);
+	}
+
+	MRKStandInImage* ms_Core;
+	MRKStandInImage* ms_Game;
+
+	void MRKBuildStandIn() {
+		MRKStandIn& rt = MRKStandInGet();
+		const int pub = IL2CPP_TYPE_ATTRIBUTE_PUBLIC;
+		const mrku32 pubMethod = IL2CPP_METHOD_ATTRIBUTE_PUBLIC;
+		const int pubField = IL2CPP_FIELD_ATTRIBUTE_PUBLIC;
+
+		ms_Core = rt.AddImage("UnityEngine.CoreModule.dll");
+		ms_Game = rt.AddImage("Assembly-CSharp.dll");
+
+		MRKStandInClass* object = rt.AddClass(ms_Core, "System", "Object", "System.Object", pub);
+		MRKStandInClass* delegate = rt.AddClass(ms_Core, "System", "MulticastDelegate", "System.MulticastDelegate", pub, object);
+		MRKStandInClass* int32 = rt.AddClass(ms_Core, "System", "Int32", "System.Int32", pub, 0, true);
+		int32->Type.Kind = MRK_TYPE_I4;
+		int32->ValueSize = 4;
+
+		MRKStandInType* voidType = rt.AddType(MRK_TYPE_VOID, "System.Void");
+		MRKStandInType* int32Type = &int32->Type;
+		MRKStandInType* floatType = rt.AddType(MRK_TYPE_R4, "System.Single");
+		MRKStandInType* stringType = rt.AddType(MRK_TYPE_STRING, "System.String");
+
+		MRKStandInClass* vector3 = rt.AddClass(ms_Core, "UnityEngine", "Vector3", "UnityEngine.Vector3", pub, 0, true);
+		vector3->ValueSize = 12;
+		rt.AddField(vector3, "x", pubField, floatType, IL2CPP_OBJECT_HEADER_SIZE);
+		rt.AddField(vector3, "y", pubField, floatType, IL2CPP_OBJECT_HEADER_SIZE + 4);
+		rt.AddField(vector3, "z", pubField, floatType, IL2CPP_OBJECT_HEADER_SIZE + 8);
+		rt.AddField(vector3, "zero", pubField | IL2CPP_FIELD_ATTRIBUTE_STATIC, &vector3->Type, 0);
+
+		MRKStandInClass* transform = rt.AddClass(ms_Core, "UnityEngine", "Transform", "UnityEngine.Transform", pub, object);
+		MRKStandInClass* component = rt.AddClass(ms_Core, "UnityEngine", "Component", "UnityEngine.Component", pub, object);
+		rt.AddMethod(component, "get_transform", pubMethod, 0x06000010, &transform->Type);
+
+		MRKStandInClass* state = rt.AddClass(ms_Game, "Game", "State", "Game.State", pub, 0, true);
+		state->EnumBase = int32Type;
+
+		rt.AddClass(ms_Game, "", "GlobalThing", "GlobalThing", pub, object);
+		rt.AddClass(ms_Game, "Game", "Internal", "Game.Internal", 0, object);
+		rt.AddClass(ms_Game, "Game", "OnHit", "Game.OnHit", pub, delegate);
+
+		MRKStandInClass* player = rt.AddClass(ms_Game, "Game", "Player", "Game.Player", pub, component);
+		rt.AddMethod(player, "Move", pubMethod | IL2CPP_METHOD_ATTRIBUTE_VIRTUAL, 0x06000001, voidType, { &vector3->Type });
+		rt.AddMethod(player, "Say", pubMethod, 0x06000002, voidType, { stringType });
+		rt.AddMethod(player, "Say", pubMethod, 0x06000003, voidType, { int32Type });
+		rt.AddMethod(player, "Create", pubMethod | IL2CPP_METHOD_ATTRIBUTE_STATIC, 0x06000004, &player->Type);
+		rt.AddMethod(player, "Hidden", 0x0001, 0x06000005, voidType);
+		rt.AddMethod(player, "Sum", pubMethod, 0x06000006, int32Type, { rt.AddArray(int32, "System.Int32[]") });
+		rt.AddMethod(player, "get_health", pubMethod, 0x06000007, int32Type)->ImplFlags = IL2CPP_METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL;
+
+		MRKStandInType* t = rt.AddType(MRK_TYPE_MVAR, "T");
+		rt.AddMethod(player, "Get", pubMethod, 0x06000010, t, {}, true);
+		rt.AddMethod(player, "Index", pubMethod, 0x06000011, voidType,
+			{ rt.AddType(MRK_TYPE_GENERICINST, "System.Collections.Generic.Dictionary`2<TKey,TValue>") }, true);
+		rt.AddMethod(player, "ToDictionary", pubMethod | IL2CPP_METHOD_ATTRIBUTE_STATIC, 0x06000012,
+			rt.AddType(MRK_TYPE_GENERICINST, "System.Collections.Generic.Dictionary`2<TKey,TSource>"),
+			{ rt.AddType(MRK_TYPE_GENERICINST, "System.Collections.Generic.IEnumerable`1<TSource>"),
+			rt.AddType(MRK_TYPE_GENERICINST, "System.Func`2<TSource,TKey>") }, true);
+		rt.AddMethod(player, "Swap", pubMethod, 0x06000013, voidType, { rt.AddType(MRK_TYPE_BYREF, "T&"), rt.AddType(MRK_TYPE_BYREF, "T&") }, true);
+		rt.AddMethod(player, "Wrap", pubMethod, 0x06000014, voidType,
+			{ rt.AddType(MRK_TYPE_GENERICINST, "System.Collections.Generic.List`1<GlobalThing>"), t }, true);
+		rt.AddMethod(player, "Make", pubMethod, 0x06000015, voidType, {}, true);
+
+		rt.AddField(player, "Health", pubField, int32Type, 0x20);
+		rt.AddField(player, "Mood", pubField, &state->Type, 0x24);
+		rt.AddField(player, "Count", pubField | IL2CPP_FIELD_ATTRIBUTE_STATIC, int32Type, 0);
+		rt.AddField(player, "Current", pubField | IL2CPP_FIELD_ATTRIBUTE_STATIC, &player->Type, (size_t)-1);
+		rt.AddField(player, "MaxHealth", pubField | IL2CPP_FIELD_ATTRIBUTE_STATIC | IL2CPP_FIELD_ATTRIBUTE_LITERAL, int32Type, 0);
+		rt.AddField(player, "secret", 0x0001, int32Type, 0x28);
+
+		rt.AddClass(ms_Game, "Game", "Enemy", "Game.Enemy", pub, player);
+
+		MRKStandInClass* box = rt.AddClass(ms_Game, "Game", "Box`1", "Game.Box`1<T>", pub, object);
+		rt.AddMethod(box, "Map", pubMethod, 0x06000020, rt.AddType(MRK_TYPE_GENERICINST, "Game.Box`1<TOut>"),
+			{ rt.AddType(MRK_TYPE_GENERICINST, "System.Func`2<T,TOut>") }, true);
+	}
+
+	void MRKTestImages() {
+		MRK_CHECK(MRKXCPPBackendGetImage("UnityEngine.CoreModule") != 0);
+		MRK_CHECK(MRKXCPPBackendGetImage("Assembly-CSharp.dll") != 0);
+		MRK_CHECK(MRKXCPPBackendGetImage("Missing") == 0);
+
+		MRKXCPPImage* image = MRKXCPPBackendGetImage("Assembly-CSharp");
+		MRK_CHECK(image && image->Ptr == ms_Game && image->Mvid == 0);
+
+		mrku32 count = MRKXCPPBackendGetClassCount(image);
+		MRK_CHECK(count == ms_Game->Classes.size());
+
+		mrku32 publicCount = 0;
+		MRKXCPPMemberInfo info;
+		for (mrku32 i = 0; i < count; i++) {
+			MRK_CHECK(MRKXCPPBackendGetClassInfo(image, i, &info));
+			publicCount += info.Public;
+
+			if (!strcmp(info.Name, "Internal"))
+				MRK_CHECK(!info.Public);
+		}
+
+		MRK_CHECK(publicCount == count - 1);
+		MRK_CHECK(!MRKXCPPBackendGetClassInfo(image, count, &info));
+	}
+
+	void MRKTestClasses() {
+		MRKXCPPImage* game = MRKXCPPBackendGetImage("Assembly-CSharp");
+		MRKXCPPImage* core = MRKXCPPBackendGetImage("UnityEngine.CoreModule");
+
+		MRKXCPPClass* player = MRKXCPPBackendGetClass(game, "Game", "Player");
+		MRK_CHECK(player != 0);
+		MRK_CHECK_STR(player->Type.Name, "Game.Player");
+		MRK_CHECK(player->Type.Kind == MRK_TYPE_CLASS);
+		MRK_CHECK_STR(player->Parents, "UnityEngine.Component,System.Object");
+		MRK_CHECK(!player->Delegate && !player->GenericParams);
+		MRK_CHECK(player->Token == 0x02000005);
+
+		MRK_CHECK(MRKXCPPBackendGetClass(game, "Game", "Missing") == 0);
+		MRK_CHECK(MRKXCPPBackendGetClass(core, "Game", "Player") == 0);
+
+		MRK_CHECK(MRKXCPPBackendGetClass(game, "Game", "OnHit")->Delegate);
+		MRK_CHECK_STR(MRKXCPPBackendGetClass(game, "Game", "Box`1")->GenericParams, "T");
+		MRK_CHECK(MRKXCPPBackendGetClass(core, "System", "Object")->Parents == 0);
+
+		//enums take their underlying kind, structs their instance fields relative to the unboxed value
+		MRK_CHECK(MRKXCPPBackendGetClass(game, "Game", "State")->Type.Kind == MRK_TYPE_I4);
+
+		MRKXCPPClass* vector3 = MRKXCPPBackendGetClass(core, "UnityEngine", "Vector3");
+		MRK_CHECK(vector3->Type.Kind == MRK_TYPE_VALUETYPE && vector3->Type.Size == 12);
+		MRK_CHECK(vector3->Type.FieldCount == 3);
+		MRK_CHECK_STR(vector3->Type.Fields[2].Name, "z");
+		MRK_CHECK(vector3->Type.Fields[2].Offset == 8 && vector3->Type.Fields[2].Kind == MRK_TYPE_R4);
+	}
+
+	void MRKTestMethods() {
+		MRKXCPPImage* game = MRKXCPPBackendGetImage("Assembly-CSharp");
+		MRKXCPPClass* player = MRKXCPPBackendGetClass(game, "Game", "Player");
+
+		mrku32 methods = 0;
+		void* iter = 0;
+		MRKXCPPMemberInfo info;
+		while (MRKXCPPBackendNextMethod(player, &iter, &info)) {
+			methods++;
+
+			if (!strcmp(info.Name, "Hidden"))
+				MRK_CHECK(!info.Public);
+			else if (!strcmp(info.Name, "Create"))
+				MRK_CHECK(info.Static && info.Public && info.ParamCount == 0);
+			else if (!strcmp(info.Name, "ToDictionary"))
+				MRK_CHECK(info.GenericArity == 2 && info.ParamCount == 2);
+			else if (!strcmp(info.Name, "Make"))
+				MRK_CHECK(info.GenericArity != 0);
+			else if (!strcmp(info.Name, "Move"))
+				MRK_CHECK(info.GenericArity == 0 && !info.Static);
+		}
+
+		MRK_CHECK(methods == 13);
+
+		MRKXCPPMethod* move = MRKXCPPBackendGetMethod(player, "Move", 1, 1);
+		MRK_CHECK(move && move->Virtual && !move->ICall && move->Token == 0x06000001);
+		MRK_CHECK_STR(move->Params[0], "UnityEngine.Vector3");
+		MRK_CHECK(move->ParamTypes[0].Kind == MRK_TYPE_VALUETYPE && move->ParamTypes[0].Size == 12);
+		MRK_CHECK(move->ReturnType.Kind == MRK_TYPE_VOID);
+		MRK_CHECK_STR(move->DeclaringClass, "Game.Player");
+
+		//overloads of the same argc are told apart by occurrence
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "Say", 1, 1)->Token == 0x06000002);
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "Say", 1, 2)->Token == 0x06000003);
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "Say", 1, 3) == 0);
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "Say", 2, 1) == 0);
+
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "get_health", 0, 1)->ICall);
+
+		MRKXCPPMethod* sum = MRKXCPPBackendGetMethod(player, "Sum", 1, 1);
+		MRK_CHECK(sum->ParamTypes[0].Kind == MRK_TYPE_SZARRAY && sum->ParamTypes[0].Element);
+		MRK_CHECK(sum->ParamTypes[0].Element->Kind == MRK_TYPE_I4);
+		MRK_CHECK(sum->ReturnType.Kind == MRK_TYPE_I4 && !sum->GenericParams);
+
+		//a method inherited from another image binds by name, its token belongs to that image
+		MRKXCPPMethod* transform = MRKXCPPBackendGetMethod(player, "get_transform", 0, 1);
+		MRK_CHECK(transform && transform->Token == 0);
+		MRK_CHECK_STR(transform->DeclaringClass, "UnityEngine.Component");
+
+		//inherited within the same image it keeps its token
+		MRKXCPPClass* enemy = MRKXCPPBackendGetClass(game, "Game", "Enemy");
+		MRKXCPPMethod* enemyMove = MRKXCPPBackendGetMethod(enemy, "Move", 1, 1);
+		MRK_CHECK(enemyMove && enemyMove->Token == 0x06000001);
+		MRK_CHECK_STR(enemyMove->DeclaringClass, "Game.Player");
+	}
+
+	void MRKTestGenericParams() {
+		MRKXCPPImage* game = MRKXCPPBackendGetImage("Assembly-CSharp");
+		MRKXCPPClass* player = MRKXCPPBackendGetClass(game, "Game", "Player");
+
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(player, "Get", 0, 1)->GenericParams, "T");
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(player, "Index", 1, 1)->GenericParams, "TKey,TValue");
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(player, "ToDictionary", 2, 1)->GenericParams, "TSource,TKey");
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(player, "Swap", 2, 1)->GenericParams, "T");
+
+		//a global namespace class nested in a generic instance is a type, not a parameter
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(player, "Wrap", 2, 1)->GenericParams, "T");
+
+		//the declaring class' own parameters are not the method's
+		MRKXCPPClass* box = MRKXCPPBackendGetClass(game, "Game", "Box`1");
+		MRK_CHECK_STR(MRKXCPPBackendGetMethod(box, "Map", 1, 1)->GenericParams, "TOut");
+
+		//nothing in the signature names the parameter, the method is refused rather than guessed
+		MRK_CHECK(MRKXCPPBackendGetMethod(player, "Make", 0, 1) == 0);
+	}
+
+	void MRKTestFields() {
+		MRKXCPPImage* game = MRKXCPPBackendGetImage("Assembly-CSharp");
+		MRKXCPPClass* player = MRKXCPPBackendGetClass(game, "Game", "Player");
+
+		mrku32 fields = 0;
+		void* iter = 0;
+		MRKXCPPMemberInfo info;
+		while (MRKXCPPBackendNextField(player, &iter, &info)) {
+			fields++;
+
+			MRK_CHECK(strcmp(info.Name, "MaxHealth") != 0);
+			if (!strcmp(info.Name, "secret"))
+				MRK_CHECK(!info.Public);
+			else if (!strcmp(info.Name, "Count"))
+				MRK_CHECK(info.Static && info.Public);
+		}
+
+		MRK_CHECK(fields == 5);
+
+		MRKXCPPField* health = MRKXCPPBackendGetField(player, "Health");
+		MRK_CHECK(health && !health->Static && health->Type.Kind == MRK_TYPE_I4 && health->Token == 0);
+
+		MRK_CHECK(MRKXCPPBackendGetField(player, "Mood")->Type.Kind == MRK_TYPE_I4);
+		MRK_CHECK(MRKXCPPBackendGetField(player, "Count")->Static);
+
+		//thread statics have no slot in the static data
+		MRK_CHECK(!MRKXCPPBackendGetField(player, "Current")->Static);
+		MRK_CHECK(!MRKXCPPBackendGetField(player, "MaxHealth")->Static);
+		MRK_CHECK(MRKXCPPBackendGetField(player, "Missing") == 0);
+
+		MRKXCPPClass* enemy = MRKXCPPBackendGetClass(game, "Game", "Enemy");
+		MRK_CHECK(MRKXCPPBackendGetField(enemy, "Health") != 0);
+	}
+
+	void MRKTestSymbols() {
+		MRKXCPPBackendSymbol* syms;
+		mrku32 count = MRKXCPPBackendGetSymbols(&syms);
+		MRK_CHECK(count == MRKStandInGetExportCount());
+
+		for (mrku32 i = 0; i < count; i++) {
+			if (syms[i].Resolved)
+				MRK_CHECK(syms[i].Ptr != 0);
+		}
+	}
+}
+
+int main() {
+	using namespace MRK;
+
+	MRKBuildStandIn();
+
+	MRK_CHECK(!MRKXCPPBackendInit("Mono"));
+	MRK_CHECK(MRKXCPPBackendInit("IL2CPP"));
+	MRK_CHECK_STR(MRKXCPPBackendGetName(), "IL2CPP");
+
+	MRKTestImages();
+	MRKTestClasses();
+	MRKTestMethods();
+	MRKTestGenericParams();
+	MRKTestFields();
+	MRKTestSymbols();
+
+	MRKAllocFreeAll();
+
+	printf("%u checks, %u failed\n", ms_Checks, ms_Failures);
+	return ms_Failures ? 1 : 0;
+}
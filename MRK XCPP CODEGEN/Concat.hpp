@@ -24,10 +24,16 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#pragma once
+
 #include <sstream>
 #include <iomanip>
 #include <tuple>
 #include <utility>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdio>
 
 namespace MRK {
 	template <typename CharT>
@@ -308,4 +314,182 @@ namespace MRK {
 			std::forward<Args>(rest)...
 			);
 	}
+
+	namespace { // concat_into_impl : size then write, every argument kind is resolved at compile time
+		template <typename T, typename = void>
+		struct concat_arg;
+
+		template <typename T>
+		struct is_narrow_char : std::integral_constant<bool,
+			std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value> {};
+
+		// chars, signed and unsigned char are written as characters too, like an ostream does
+		template <typename T>
+		struct concat_arg<T, enable_if_t<is_narrow_char<T>::value>> {
+			static size_t size(T) { return 1; }
+			static char* write(char* out, T c) { *out = (char)c; return out + 1; }
+		};
+
+		// cstrings, string literals decay here as well
+		template <typename T>
+		struct concat_arg<T, enable_if_t<is_c_str<T, char>::value>> {
+			static size_t size(const char* s) { return s ? strlen(s) : 0; }
+			static char* write(char* out, const char* s) {
+				size_t len = size(s);
+				memcpy(out, s, len);
+				return out + len;
+			}
+		};
+
+		// std::string and std::string_view
+		template <typename T>
+		struct concat_arg<T, enable_if_t<std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value>> {
+			static size_t size(const T& s) { return s.size(); }
+			static char* write(char* out, const T& s) {
+				memcpy(out, s.data(), s.size());
+				return out + s.size();
+			}
+		};
+
+		// bools, written the way an ostream without boolalpha would
+		template <>
+		struct concat_arg<bool> {
+			static size_t size(bool) { return 1; }
+			static char* write(char* out, bool b) { *out = b ? '1' : '0'; return out + 1; }
+		};
+
+		// integers
+		template <typename T>
+		struct concat_arg<T, enable_if_t<std::is_integral<T>::value && !is_narrow_char<T>::value && !std::is_same<T, bool>::value>> {
+			typedef typename std::make_unsigned<T>::type U;
+
+			static bool negative(T v) {
+				if constexpr (std::is_signed_v<T>)
+					return v < 0;
+				else
+					return false;
+			}
+
+			static U magnitude(T v) { return negative(v) ? U(0) - U(v) : U(v); }
+
+			static size_t size(T v) {
+				size_t len = negative(v) ? 2 : 1;
+				for (U m = magnitude(v); m >= 10; m /= 10)
+					len++;
+
+				return len;
+			}
+
+			static char* write(char* out, T v) {
+				char* end = out + size(v);
+				char* p = end;
+				U m = magnitude(v);
+				do {
+					*--p = char('0' + m % 10);
+					m /= 10;
+				} while (m);
+
+				if (negative(v))
+					*out = '-';
+
+				return end;
+			}
+		};
+
+		// floating point, same default precision as an ostream
+		template <typename T>
+		struct concat_arg<T, enable_if_t<std::is_floating_point<T>::value>> {
+			static size_t size(T v) { return (size_t)snprintf(0, 0, "%g", (double)v); }
+			static char* write(char* out, T v) {
+				char buf[32];
+				size_t len = (size_t)snprintf(buf, sizeof(buf), "%g", (double)v);
+				memcpy(out, buf, len);
+				return out + len;
+			}
+		};
+
+		// raw pointers that are not cstrings
+		template <typename T>
+		struct concat_arg<T, enable_if_t<std::is_pointer<T>::value && !is_char_sequence<T>::value>> {
+			static size_t size(T p) { return (size_t)snprintf(0, 0, "%p", (const void*)p); }
+			static char* write(char* out, T p) {
+				char buf[32];
+				size_t len = (size_t)snprintf(buf, sizeof(buf), "%p", (const void*)p);
+				memcpy(out, buf, len);
+				return out + len;
+			}
+		};
+
+		template <typename T>
+		size_t concat_into_size(const T& element);
+
+		template <typename T>
+		char* concat_into_write(char* out, const T& element);
+
+		// containers, arrays, and any iterable type EXCEPT the standard string types
+		template <typename T>
+		struct concat_arg<T, enable_if_t<is_iterable<T>::value && !std::is_same<T, std::string_view>::value>> {
+			static size_t size(const T& container) {
+				size_t len = 0;
+				for (const auto& element : container)
+					len += concat_into_size(element);
+
+				return len;
+			}
+
+			static char* write(char* out, const T& container) {
+				for (const auto& element : container)
+					out = concat_into_write(out, element);
+
+				return out;
+			}
+		};
+
+		// std::pairs and std::tuples
+		template <typename P1, typename P2>
+		struct concat_arg<std::pair<P1, P2>> {
+			static size_t size(const std::pair<P1, P2>& pair) {
+				return concat_into_size(pair.first) + concat_into_size(pair.second);
+			}
+
+			static char* write(char* out, const std::pair<P1, P2>& pair) {
+				return concat_into_write(concat_into_write(out, pair.first), pair.second);
+			}
+		};
+
+		template <typename... Args>
+		struct concat_arg<std::tuple<Args...>> {
+			static size_t size(const std::tuple<Args...>& tuple) {
+				return std::apply([](const auto&... element) { return (size_t(0) + ... + concat_into_size(element)); }, tuple);
+			}
+
+			static char* write(char* out, const std::tuple<Args...>& tuple) {
+				std::apply([&out](const auto&... element) { ((out = concat_into_write(out, element)), ...); }, tuple);
+				return out;
+			}
+		};
+
+		template <typename T>
+		size_t concat_into_size(const T& element) {
+			return concat_arg<typename std::decay<T>::type>::size(element);
+		}
+
+		template <typename T>
+		char* concat_into_write(char* out, const T& element) {
+			return concat_arg<typename std::decay<T>::type>::write(out, element);
+		}
+	}
+
+	// appends every argument to out without a separator, the total size is computed up front so out grows at most once,
+	// a reused out never allocates
+	template <typename... Args>
+	std::string& concat_into(std::string& out, const Args& ... seq) {
+		size_t at = out.size();
+		out.resize(at + (size_t(0) + ... + concat_into_size(seq)));
+
+		char* p = &out[0] + at;
+		((p = concat_into_write(p, seq)), ...);
+
+		return out;
+	}
 }
\ No newline at end of file
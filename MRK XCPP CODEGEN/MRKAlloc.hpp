@@ -26,53 +26,148 @@
 
 #pragma once
 
-#include <vector>
+#include <unordered_map>
 #include <malloc.h>
 #include <algorithm>
+#include <mutex>
+#include <cstring>
 
 #include "MRKCommon.h"
 
 namespace MRK {
-	static mrks vector<void*> mrk_stored_ptrs;
+	enum MRKAllocCategory {
+		MRK_ALLOC_OTHER,
+		MRK_ALLOC_IMAGE,
+		MRK_ALLOC_CLASS,
+		MRK_ALLOC_METHOD,
+		MRK_ALLOC_FIELD,
+		MRK_ALLOC_TYPE,
+		MRK_ALLOC_NAME,
+		MRK_ALLOC_PARAMS,
+		MRK_ALLOC_CACHE,
+		MRK_ALLOC_REGISTRY,
+		MRK_ALLOC_CATEGORY_COUNT
+	};
 
-	template<typename T>
-	inline T* MRKAllocNew() {
-		T* ptr = (T*)malloc(sizeof(T));
-		mrk_stored_ptrs.push_back((void*)ptr);
+	struct MRKAllocStats {
+		mrku32ptr Current; //bytes
+		mrku32ptr Peak;
+		mrku32ptr Count; //live allocations
+	};
+
+	struct MRKAllocRecord {
+		mrku32ptr Size;
+		MRKAllocCategory Category;
+	};
+
+	inline mrks unordered_map<void*, MRKAllocRecord> mrk_stored_ptrs; //shared across translation units, the backend allocates what MRKXCPP frees
+	inline MRKAllocStats mrk_alloc_stats[MRK_ALLOC_CATEGORY_COUNT];
+	inline mrks recursive_mutex mrk_stored_lock; //the MRKXCPP caches resolve on several threads
+	inline mrku32ptr mrk_stored_bucket_bytes; //reported size of mrk_stored_ptrs' bucket array
+
+	inline const char* MRKAllocCategoryName(MRKAllocCategory category) {
+		static const char* names[MRK_ALLOC_CATEGORY_COUNT] = { "other", "images", "classes", "methods", "fields", "types", "names", "param arrays", "caches", "allocation registry" };
+		return category < MRK_ALLOC_CATEGORY_COUNT ? names[category] : "?";
+	}
+
+	//also counts memory that does not go through MRKAllocNew, e.g. the interned name chunks
+	inline void MRKAllocTrack(MRKAllocCategory category, mrku32ptr sz) {
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+
+		MRKAllocStats& stats = mrk_alloc_stats[category];
+		stats.Current += sz;
+		stats.Count++;
+		stats.Peak = mrks max(stats.Peak, stats.Current);
+	}
+
+	inline void MRKAllocUntrack(MRKAllocCategory category, mrku32ptr sz) {
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+
+		MRKAllocStats& stats = mrk_alloc_stats[category];
+		stats.Current -= sz;
+		stats.Count--;
+	}
+
+	//the registry's own node (entry, next and cached hash) and bucket array, as the standard library lays them out
+	inline void MRKAllocTrackRegistry(bool insert) {
+		mrku32ptr nodeBytes = sizeof(decltype(mrk_stored_ptrs)::value_type) + sizeof(void*) + sizeof(size_t);
+		if (insert)
+			MRKAllocTrack(MRK_ALLOC_REGISTRY, nodeBytes);
+		else
+			MRKAllocUntrack(MRK_ALLOC_REGISTRY, nodeBytes);
+
+		mrku32ptr bucketBytes = mrk_stored_ptrs.bucket_count() * sizeof(void*);
+		if (bucketBytes != mrk_stored_bucket_bytes) {
+			if (mrk_stored_bucket_bytes)
+				MRKAllocUntrack(MRK_ALLOC_REGISTRY, mrk_stored_bucket_bytes);
+
+			MRKAllocTrack(MRK_ALLOC_REGISTRY, bucketBytes);
+			mrk_stored_bucket_bytes = bucketBytes;
+		}
+	}
+
+	inline MRKAllocStats MRKAllocGetStats(MRKAllocCategory category) {
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+		return mrk_alloc_stats[category];
+	}
+
+	inline void* MRKAllocRaw(mrku32ptr sz, MRKAllocCategory category) {
+		void* ptr = malloc(sz);
+
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+		mrk_stored_ptrs[ptr] = { sz, category };
+		MRKAllocTrack(category, sz);
+		MRKAllocTrackRegistry(true);
 
 		return ptr;
 	}
 
+	template<typename T>
+	inline T* MRKAllocNew(MRKAllocCategory category = MRK_ALLOC_OTHER) {
+		return (T*)MRKAllocRaw(sizeof(T), category);
+	}
+
 	template<typename T>
 	inline T* MRKAllocNew(void* oldPtr) {
-		for (void* ptrs : mrk_stored_ptrs) {
-			if (((mrku32ptr)ptrs) == ((mrku32ptr)oldPtr))
-				return (T*)ptrs;
-		}
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+		if (mrk_stored_ptrs.count(oldPtr))
+			return (T*)oldPtr;
 
 		return MRKAllocNew<T>();
 	}
 
 	template<typename T>
-	inline T* MRKAllocNewArr(mrku32 sz) {
-		T* ptr = (T*)malloc(sizeof(T) * sz);
-		mrk_stored_ptrs.push_back((void*)ptr);
-
-		return ptr;
+	inline T* MRKAllocNewArr(mrku32 sz, MRKAllocCategory category = MRK_ALLOC_OTHER) {
+		return (T*)MRKAllocRaw(sizeof(T) * sz, category);
 	}
 
 	template<typename T>
 	inline void MRKAllocFree(T* ptr) {
-		if (!(MRK_VEC_CONTAIN(mrk_stored_ptrs, ptr)))
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+
+		auto it = mrk_stored_ptrs.find((void*)ptr);
+		if (it == mrk_stored_ptrs.end())
 			return;
 
-		mrk_stored_ptrs.erase(mrks remove(mrk_stored_ptrs.begin(), mrk_stored_ptrs.end(), 
-			(void*)ptr), mrk_stored_ptrs.end());
-		free(ptr);
+		MRKAllocUntrack(it->second.Category, it->second.Size);
+		mrk_stored_ptrs.erase(it);
+		MRKAllocTrackRegistry(false);
+		free((void*)ptr);
 	}
 
 	inline void MRKAllocFreeAll() {
-		for (mrku32 idx = mrk_stored_ptrs.size() - 1; idx > -1; idx--)
-			MRKAllocFree<void>(mrk_stored_ptrs[idx]);
+		mrks lock_guard<mrks recursive_mutex> lock(mrk_stored_lock);
+		while (!mrk_stored_ptrs.empty())
+			MRKAllocFree<void>(mrk_stored_ptrs.begin()->first);
+	}
+
+	inline void MRKCopyString(char** dest, const char* src, MRKAllocCategory category) {
+		if (!dest || !src)
+			return;
+
+		mrku32 nLen = strlen(src);
+		*dest = MRKAllocNewArr<char>(nLen + 1, category);
+		strcpy(*dest, src);
+		(*dest)[nLen] = '\0';
 	}
-}
\ No newline at end of file
+}
@@ -26,15 +26,12 @@
 
 #include "MRKCodeWriter.h"
 #include "Concat.hpp"
+#include "MRKLog.h"
 
 #include <filesystem>
-#include <Shlobj.h>
+#include <stdexcept>
 
 namespace MRK {
-	void MRKCodeWriter::WriteLine(mrks string line) {
-		m_CurrentStream->Stream << Replicate('\t', m_CurrentStream->IndentCount) << line << '\n';
-	}
-
 	mrks string MRKCodeWriter::Replicate(char c, mrku32 times) {
 		mrks string str;
 		for (mrku32 i = 0; i < times; i++)
@@ -77,20 +74,230 @@ namespace MRK {
 			m_RegParams.push_back(param);
 	}
 
+	const char* MRKCodeWriter::GetPrimitiveType(mrku32 kind) {
+		switch (kind) {
+		case MRK_TYPE_BOOLEAN: return "bool";
+		case MRK_TYPE_CHAR: return "char16_t";
+		case MRK_TYPE_I1: return "signed char";
+		case MRK_TYPE_U1: return "unsigned char";
+		case MRK_TYPE_I2: return "short";
+		case MRK_TYPE_U2: return "unsigned short";
+		case MRK_TYPE_I4: return "int";
+		case MRK_TYPE_U4: return "unsigned int";
+		case MRK_TYPE_I8: return "long long";
+		case MRK_TYPE_U8: return "unsigned long long";
+		case MRK_TYPE_R4: return "float";
+		case MRK_TYPE_R8: return "double";
+		case MRK_TYPE_I: return "intptr_t";
+		case MRK_TYPE_U: return "uintptr_t";
+		}
+
+		return 0;
+	}
+
+	mrku32 MRKCodeWriter::GetPrimitiveSize(mrku32 kind) {
+		switch (kind) {
+		case MRK_TYPE_BOOLEAN: case MRK_TYPE_I1: case MRK_TYPE_U1: return 1;
+		case MRK_TYPE_CHAR: case MRK_TYPE_I2: case MRK_TYPE_U2: return 2;
+		case MRK_TYPE_I4: case MRK_TYPE_U4: case MRK_TYPE_R4: return 4;
+		case MRK_TYPE_I8: case MRK_TYPE_U8: case MRK_TYPE_R8: return 8;
+		case MRK_TYPE_I: case MRK_TYPE_U: return sizeof(void*);
+		}
+
+		return 0;
+	}
+
+	bool MRKCodeWriter::IsReferenceKind(mrku32 kind) {
+		return kind == MRK_TYPE_STRING || kind == MRK_TYPE_CLASS || kind == MRK_TYPE_OBJECT
+			|| kind == MRK_TYPE_SZARRAY || kind == MRK_TYPE_ARRAY || kind == MRK_TYPE_PTR;
+	}
+
+	mrks string MRKCodeWriter::GetNativeType(MRKXCPPType& type) {
+		//returns an empty string for types that stay opaque void*
+		if (const char* primitive = GetPrimitiveType(type.Kind))
+			return primitive;
+
+		if (type.Kind != MRK_TYPE_VALUETYPE || !type.Size)
+			return "";
+
+		mrks string name = concat(type.Name, "_VALUE");
+		for (char& c : name) {
+			if (!isalnum((unsigned char)c))
+				c = '_';
+		}
+
+		RegValueType(name, type);
+		return name;
+	}
+
+	mrku32 MRKCodeWriter::GetGenericParamIndex(mrks string name) {
+		const char* params = m_CurrentStream->Class->GenericParams;
+		if (!params)
+			return MRK_XCPP_GENERIC_PARAM_NONE;
+
+		mrks string list = concat(',', params, ',');
+		size_t pos = list.find(concat(',', name, ','));
+		if (pos == mrks string::npos)
+			return MRK_XCPP_GENERIC_PARAM_NONE;
+
+		return (mrku32)mrks count(list.begin(), list.begin() + pos, ',');
+	}
+
+	mrks string MRKCodeWriter::GetStorageType(MRKXCPPType& type) {
+		//what a slot of this type holds, empty when unknown
+		if (type.Kind == MRK_TYPE_VAR) {
+			//only an instantiation knows what its generic parameters hold
+			mrku32 idx = GetGenericParamIndex(type.Name);
+			if (!m_Inflating || idx == MRK_XCPP_GENERIC_PARAM_NONE)
+				return "";
+
+			return concat("typename MRKXCPPStorageOf<T", idx, ">::Type");
+		}
+
+		if (type.Kind == MRK_TYPE_SZARRAY && type.Element) {
+			mrks string element = GetStorageType(*type.Element);
+			return element.empty() ? "void*" : concat("MRKXCPPArray<", element, ">");
+		}
+
+		if (type.Kind == MRK_TYPE_STRING)
+			return "MRKXCPPStringView";
+
+		mrks string native = GetNativeType(type);
+		if (native.empty() && IsReferenceKind(type.Kind))
+			return "void*";
+
+		return native;
+	}
+
+	mrks string MRKCodeWriter::GetViewType(MRKXCPPType& type) {
+		//object returns that can be typed without unboxing, the rest stay void*
+		if (type.Kind == MRK_TYPE_SZARRAY || type.Kind == MRK_TYPE_STRING)
+			return GetStorageType(type);
+
+		return "void*";
+	}
+
+	void MRKCodeWriter::RegValueType(mrks string& name, MRKXCPPType& type) {
+		if (MRK_VEC_CONTAIN(m_RegValueTypes, name))
+			return;
+
+		m_RegValueTypes.push_back(name);
+
+		mrks vector<MRKXCPPValueField*> fields;
+		for (mrku32 i = 0; i < type.FieldCount; i++)
+			fields.push_back(&type.Fields[i]);
+
+		mrks sort(fields.begin(), fields.end(), [](MRKXCPPValueField* x, MRKXCPPValueField* y) {
+			return x->Offset < y->Offset;
+		});
+
+		mrks string def = concat("struct ", name, " {\n");
+		mrku32 cursor = 0;
+		bool opaque = fields.empty();
+
+		for (mrku32 i = 0; i < fields.size() && !opaque; i++) {
+			MRKXCPPValueField* field = fields[i];
+			mrku32 end = i < fields.size() - 1 ? fields[i + 1]->Offset : type.Size;
+
+			//explicit layouts overlap, those stay opaque
+			if (field->Offset < cursor || end < field->Offset || end > type.Size) {
+				opaque = true;
+				break;
+			}
+
+			if (field->Offset > cursor)
+				concat_into(def, "\tunsigned char __pad", cursor, '[', field->Offset - cursor, "];\n");
+
+			mrks string fieldName = field->Name;
+			for (char c : fieldName) {
+				if (!isalnum((unsigned char)c) && c != '_') {
+					fieldName = concat("__field", i);
+					break;
+				}
+			}
+
+			const char* primitive = GetPrimitiveType(field->Kind);
+			mrku32 size = primitive ? GetPrimitiveSize(field->Kind) : IsReferenceKind(field->Kind) ? sizeof(void*) : 0;
+
+			if (size && field->Offset + size <= end) {
+				concat_into(def, '\t', primitive ? primitive : "void*", ' ', fieldName, ";\n");
+				cursor = field->Offset + size;
+			}
+			else {
+				//nested structs span up to the next field
+				concat_into(def, "\tunsigned char ", fieldName, '[', end - field->Offset, "];\n");
+				cursor = end;
+			}
+		}
+
+		if (opaque)
+			def = concat("struct ", name, " {\n\tunsigned char __data[", type.Size, "];\n");
+		else if (cursor < type.Size)
+			concat_into(def, "\tunsigned char __pad", cursor, '[', type.Size - cursor, "];\n");
+
+		concat_into(def, "};\nstatic_assert(sizeof(", name, ") == ", type.Size, ", \"", type.Name, " layout mismatch\");\n");
+		m_ValueTypeDefs.push_back(def);
+	}
+
 	MRKCodeWriter::MRKCodeWriter(mrks string dir) {
 		m_CurrentStream = 0;
+		m_Inflating = false;
 		m_ParentDir = dir;
-		m_InitializeStream = mrks ofstream(concat(dir, "\\MRKXCPPInit.cpp"), mrks ios_base::out);
+		m_InitializeStream = mrks ofstream(concat(dir, MRK_PATH_SEP "MRKXCPPInit.cpp"), mrks ios_base::out);
+
+		//init calls are spooled to disk as classes close, so nothing per class outlives CloseClass
+		m_InitializeBodyPath = concat(dir, MRK_PATH_SEP "MRKXCPPInit.tmp");
+		m_InitializeBodyStream = mrks ofstream(m_InitializeBodyPath, mrks ios_base::out);
+
+		m_WarmupBodyPath = concat(dir, MRK_PATH_SEP "MRKXCPPWarmup.tmp");
+		m_WarmupBodyStream = mrks ofstream(m_WarmupBodyPath, mrks ios_base::out);
+
+		m_InitializeStream << "//GENERATED BY MRK XCPP CODEGEN\n\n";
+		m_InitializeStream << "#include \"MRKXCPPGen.h\"\n";
+		m_InitializeStream << "#include \"MRKXCPPInit.h\"\n";
+	}
+
+	void MRKCodeWriter::RegClass(const char* namespaze, const char* name) {
+		//bases have to be known before the first class opens, classes derive from bound ancestors only
+		m_BoundClasses.insert(concat(namespaze, '.', name));
+	}
+
+	mrks string MRKCodeWriter::GetBaseClass(MRKXCPPClass* clazz) {
+		//nearest bound ancestor, generic ones are templates of their own and are skipped
+		if (!clazz->Parents)
+			return "";
+
+		mrks string parents = clazz->Parents;
+		for (size_t start = 0, end; start < parents.size(); start = end + 1) {
+			end = parents.find(',', start);
+			if (end == mrks string::npos)
+				end = parents.size();
+
+			mrks string parent = parents.substr(start, end - start);
+			if (parent.find('`') == mrks string::npos && m_BoundClasses.count(parent))
+				return parent;
+		}
+
+		return "";
+	}
+
+	bool MRKCodeWriter::IsInheritedMethod(MRKXCPPMethod* method) {
+		//declared by a bound base, which the C++ class derives from through GetBaseClass
+		if (!method->DeclaringClass || !method->Class->Parents || !m_BoundClasses.count(method->DeclaringClass))
+			return false;
+
+		mrks string parents = concat(',', method->Class->Parents, ',');
+		return parents.find(concat(',', method->DeclaringClass, ',')) != mrks string::npos;
 	}
 
 	void MRKCodeWriter::OpenClass(MRKXCPPClass* clazz) {
 		//find class path
 		mrks string nms = "";
 		if (clazz->Namespace && strlen(clazz->Namespace))
-			nms = '\\' + Replace(mrks string(clazz->Namespace), ".", "\\");
+			nms = MRK_PATH_SEP + Replace(mrks string(clazz->Namespace), ".", MRK_PATH_SEP);
 
 		mrks string classDir = m_ParentDir + nms;
-		mrks string classPath = concat(classDir, "\\", Replace(clazz->Name, "`", "_gctx"), ".hpp");
+		mrks string classPath = concat(classDir, MRK_PATH_SEP, Replace(clazz->Name, "`", "_gctx"), ".hpp");
 
 		auto x = m_OpenedStreams.find(classPath);
 		if (x == m_OpenedStreams.end()) {
@@ -111,15 +318,17 @@ namespace MRK {
 
 
 			if (!mrksfs is_directory(classDir))
-				SHCreateDirectoryExA(0, classDir.c_str(), 0);
-				//mrksfs create_directory(classDir);
+				mrksfs create_directories(classDir);
 
 			m_OpenedStreams.insert(mrks make_pair(classPath, MRKCodeStream{
 				mrks ofstream(classPath, mrks ios_base::out),
 				0,
 				false,
 				classPath,
-				clazz
+				clazz,
+				{},
+				{},
+				{}
 			}));
 
 			m_CurrentStream = &m_OpenedStreams.at(classPath);
@@ -144,9 +353,18 @@ namespace MRK {
 			}
 
 			mrks string depth = Replicate("../", nmsDepthC);
-			WriteLine(concat("\n#include \"", depth, "MRKXCPPGen.h\""));
-			WriteLine(concat("#include \"", depth, "MRKXCPPTypes.h\"\n"));
-			WriteLine(concat("namespace ", Replace(clazz->Namespace, ".", "::"), " {"));
+			WriteLine("\n#pragma once");
+			WriteLine("\n#include \"", depth, "MRKXCPPGen.h\"");
+			WriteLine("#include \"", depth, "MRKXCPPTypes.h\"");
+			WriteLine("#include \"", depth, "MRKXCPPRuntime.h\"");
+
+			//the base's header, from the generated root
+			mrks string base = GetBaseClass(clazz);
+			if (!base.empty())
+				WriteLine("#include \"", depth, Replace(Replace(base, ".", "/"), "`", "_gctx"), ".hpp\"");
+
+			WriteLine();
+			WriteLine("namespace ", Replace(clazz->Namespace, ".", "::"), " {");
 			Increment();
 
 			m_CurrentStream->IsDirty = true;
@@ -155,15 +373,28 @@ namespace MRK {
 			// 2!!!!!
 			//m_CurrentStream->Stream
 			//stream opened before, LATE FEATURE
-			mrks _Xruntime_error(concat("Stream '", m_CurrentStream->ClassPath, "' has been opened before!").c_str());
+			throw mrks runtime_error(concat("Stream '", m_CurrentStream->ClassPath, "' has been opened before!").c_str());
 		}
 
-		WriteLine(concat("class ", Replace(clazz->Name, "`", "_gctx"), " {"));
+		//mirrors the managed hierarchy, inherited methods come from the base's bindings
+		mrks string base = GetBaseClass(clazz);
+		if (base.empty())
+			WriteLine("class ", Replace(clazz->Name, "`", "_gctx"), " {");
+		else
+			WriteLine("class ", Replace(clazz->Name, "`", "_gctx"), " : public ::", Replace(base, ".", "::"), " {");
 
 		WriteLine("public:");
 		Increment();
 
 		WriteLine("static void* __class;");
+		WriteLine("static void* __methods[];");
+
+		//what a slot typed by this class holds, picked up by MRKXCPPStorageOf
+		mrks string storage = GetStorageType(clazz->Type);
+		WriteLine("typedef ", storage.empty() ? "void*" : storage, " __storage;");
+
+		//owning reference that survives across frames
+		WriteLine("typedef MRKXCPPHandle<", Replace(clazz->Name, "`", "_gctx"), "> __Handle;");
 
 		Decrement();
 
@@ -171,12 +402,41 @@ namespace MRK {
 
 		//write constructor
 		Increment();
+		EmitCtor("__class");
+	}
+
+	mrku32 MRKCodeWriter::RegImage(MRKXCPPImage* image) {
+		for (mrku32 i = 0; i < m_RegImages.size(); i++) {
+			if (m_RegImages[i] == image)
+				return i;
+		}
+
+		//looked up once per image at the top of its first class, 0 makes every member of it fall back to names
+		mrku32 idx = m_RegImages.size();
+		m_RegImages.push_back(image);
+
+		m_InitializeBodyStream << "\t\tvoid* __image" << idx << " = ";
+		if (image->Mvid)
+			m_InitializeBodyStream << "MRKRuntimeGetImage(E(\"" << image->Name << "\"), E(\"" << image->Mvid << "\"));\n";
+		else
+			m_InitializeBodyStream << "0;\n";
+
+		return idx;
+	}
+
+	mrks string MRKCodeWriter::FormatToken(mrku32 token) {
+		char buf[16];
+		snprintf(buf, sizeof(buf), "0x%08Xu", token);
+		return buf;
+	}
+
+	void MRKCodeWriter::EmitCtor(const char* clazz) {
 		WriteLine("static void* __new(void** args = 0, unsigned int argc = 0) {");
 		Increment();
 
 		WriteLine("__protect();");
 
-		WriteLine("return MRKRuntimeInvokeCtor(__class, args, argc);");
+		WriteLine("return MRKRuntimeInvokeCtor(", clazz, ", args, argc);");
 
 		WriteLine("__end();");
 
@@ -184,43 +444,426 @@ namespace MRK {
 		WriteLine("}");
 	}
 
-	void MRKCodeWriter::WriteMethod(MRKXCPPMethod* method, bool sttic) {
+	void MRKCodeWriter::GetMethodTypeParams(MRKXCPPMethod* method, mrks string& typeParams, mrks string& typeArgs) {
+		//generic methods become member templates over M0..Mn, kept apart from the T0..Tn of the class' instantiation
+		if (!method->GenericParams)
+			return;
+
+		mrks string genericParams = concat(',', method->GenericParams, ',');
+		mrku32 arity = mrks count(genericParams.begin(), genericParams.end(), ',') - 1;
+		for (mrku32 i = 0; i < arity; i++) {
+			concat_into(typeParams, i ? ", " : "", "typename M", i);
+			concat_into(typeArgs, i ? ", " : "", 'M', i);
+		}
+	}
+
+	mrks string MRKCodeWriter::GetParamType(MRKXCPPMethod* method, mrku32 idx) {
+		//a method type parameter, not a type of its own
+		if (method->GenericParams && concat(',', method->GenericParams, ',').find(concat(',', method->Params[idx], ',')) != mrks string::npos)
+			return "void*";
+
+		//generic instances, nested types and pointers ("Converter`2<T,TOutput>", "Player/Inner", "Foo*") keep only identifier characters
+		mrks string param = Replace(Replace(Replace(method->Params[idx], "[]", "_ARRAY"), "&", "_REF"), "*", "_PTR");
+		for (char& c : param) {
+			if (!isalnum((unsigned char)c))
+				c = '_';
+		}
+
+		RegParam(param);
+		return param;
+	}
+
+	void MRKCodeWriter::EmitMethod(MRKXCPPMethod* method, bool sttic, const char* clazz, int slot) {
+		mrks string typeParams;
+		mrks string typeArgs;
+		GetMethodTypeParams(method, typeParams, typeArgs);
+
 		mrks string paramStr;
 		mrks string invokeStr;
+		mrks string textParamStr;
+		mrks string textForwardStr;
+		mrks string charParamStr;
+		mrks string charForwardStr;
+		bool hasText = false;
 		for (mrku32 i = 0; i < method->ParamCount; i++) {
-			mrks string param = Replace(Replace(method->Params[i], ".", "_"), "[]", "_ARRAY");
-			RegParam(param);
+			mrks string param = GetParamType(method, i);
 
-			paramStr += concat(param, " arg", i, ", ");
-			invokeStr += concat("arg", i);
+			concat_into(paramStr, param, " arg", i, ", ");
+			concat_into(invokeStr, "arg", i);
+
+			if (!strcmp(method->Params[i], "System.String")) {
+				hasText = true;
+				concat_into(textParamStr, "std::string_view arg", i, ", ");
+				concat_into(textForwardStr, "MRKXCPPString(arg", i, "), ");
+				concat_into(charParamStr, "__C* arg", i, ", ");
+				concat_into(charForwardStr, "std::string_view(arg", i, "), ");
+			}
+			else {
+				concat_into(textParamStr, param, " arg", i, ", ");
+				concat_into(textForwardStr, "arg", i, ", ");
+				concat_into(charParamStr, param, " arg", i, ", ");
+				concat_into(charForwardStr, "arg", i, ", ");
+			}
 
 			if (i < method->ParamCount - 1)
 				invokeStr += ", ";
 		}
 
 		paramStr += "void* instance = 0";
+		textParamStr += "void* instance = 0";
+		textForwardStr += "instance";
+		charParamStr += "void* instance = 0";
+		charForwardStr += "instance";
+
+		//primitives and value types come back by value instead of as boxed objects
+		mrks string ret = GetNativeType(method->ReturnType);
+
+		//arrays and strings come back as views over their storage, which still convert to void*
+		mrks string view = GetViewType(method->ReturnType);
+		mrks string retType = ret.empty() ? view : ret;
 
-		WriteLine(concat("static void* ", method->Name, "(", paramStr, ") {"));
+		if (!typeParams.empty())
+			WriteLine("template<", typeParams, ">");
+
+		WriteLine("static ", retType, ' ', method->Name, "(", paramStr, ") {");
 		Increment();
 
 		WriteLine("__protect();");
 
-		WriteLine(concat("return MRKRuntimeInvoke(__class, E(\"", method->Name, "\"), N(" , method->ParamCount, 
-			"), instance, new void*[", method->ParamCount, "] { ", invokeStr, " }, ", sttic ? "true" : "false", ", N(", method->Occurance, "));"));
+		//bound classes resolve their methods once in MRK_XCPP_INIT, instantiations on first call
+		mrks string methodExpr = concat("__methods[", slot, ']');
+		if (slot < 0) {
+			WriteLine("static void* __method = MRKRuntimeGetMethod(", clazz, ", E(\"", method->Name, "\"), N(", method->ParamCount, "), N(", method->Occurance, "));");
+			methodExpr = "__method";
+		}
+
+		//one inflated method per type argument list, held by this instantiation of the template
+		if (!typeArgs.empty()) {
+			WriteLine("static void* __inflatedMethod = MRKXCPPInflateMethod<", typeArgs, ">(", methodExpr, ");");
+			methodExpr = "__inflatedMethod";
+		}
+
+		//virtual calls run the receiver's override, resolved once per receiver class the call site sees.
+		//value types are sealed and their instance is the unboxed value, which has no class to look up
+		bool dispatch = method->Virtual && !sttic && m_CurrentStream->Class->Type.Kind != MRK_TYPE_VALUETYPE;
+		if (dispatch) {
+			WriteLine("static MRKXCPPInlineCache __cache;");
+			WriteLine("MRKXCPPVirtualTarget* __target = __cache.Lookup(instance, ", methodExpr, ");");
+			methodExpr = "__target->Method";
+		}
+
+		//trivial getters and setters touch their backing field directly. a null instance still goes through
+		//the call for its exception, setters only store primitives so no GC write barrier is skipped
+		if (method->BackingField && !dispatch && !sttic && typeArgs.empty() && m_CurrentStream->Class->Type.Kind != MRK_TYPE_VALUETYPE) {
+			bool setter = method->ParamCount == 1;
+			mrks string field = setter ? GetICallType(method->ParamTypes[0]) : GetICallType(method->ReturnType);
+			if (!setter && !ret.empty())
+				field = ret;
+
+			if (!field.empty() && field != "void" && (!setter || GetPrimitiveType(method->ParamTypes[0].Kind))) {
+				WriteLine("static int __offset = MRKRuntimeGetFieldOffset(MRKRuntimeGetField(", clazz, ", E(\"", method->BackingField, "\")));");
+				if (setter) {
+					WriteLine("if (__offset && instance) {");
+					Increment();
+					WriteLine("*(", field, "*)((char*)instance + __offset) = *(", field, "*)arg0;");
+					WriteLine("return 0;");
+					Decrement();
+					WriteLine("}");
+				}
+				else {
+					WriteLine("if (__offset && instance)");
+					Increment();
+					WriteLine("return *(", field, "*)((char*)instance + __offset);");
+					Decrement();
+				}
+			}
+		}
+
+		//icalls and il2cpp method pointers take every parameter as itself, which only works without marshaling
+		mrks string directRet = !dispatch && typeArgs.empty() ? GetICallType(method->ReturnType) : "";
+		mrks string directSig = sttic ? "" : "void*";
+		mrks string directArgs = sttic ? "" : "instance";
+		for (mrku32 i = 0; i < method->ParamCount && !directRet.empty(); i++) {
+			mrks string type = GetICallType(method->ParamTypes[i]);
+			if (type.empty() || type == "void") {
+				directRet.clear();
+				break;
+			}
+
+			const char* sep = directSig.empty() ? "" : ", ";
+			concat_into(directSig, sep, type);
+
+			//invoke args point at primitives and are the object itself for references
+			if (GetPrimitiveType(method->ParamTypes[i].Kind))
+				concat_into(directArgs, sep, "*(", type, "*)arg", i);
+			else
+				concat_into(directArgs, sep, "arg", i);
+		}
+
+		if (!directRet.empty()) {
+			//internal calls skip the managed wrapper
+			if (method->ICall)
+				EmitDirectCall("__icall", concat("MRKRuntimeGetICall(", methodExpr, ')'), directRet, directSig, directArgs);
+
+			//code il2cpp compiled the method to, which takes the method itself as a trailing hidden argument
+			const char* sep = directSig.empty() ? "" : ", ";
+			EmitDirectCall("__native", concat("MRKRuntimeGetMethodPointer(", methodExpr, ')'), directRet,
+				concat(directSig, sep, "void*"), concat(directArgs, sep, methodExpr));
+		}
+
+		if (!ret.empty() && !method->ParamCount) {
+			//nothing to marshal, the unmanaged thunk returns the value without boxing it at all
+			if (dispatch)
+				WriteLine("void* __thunk = __target->GetThunk();");
+			else
+				WriteLine("static void* __thunk = MRKRuntimeGetThunk(", methodExpr, ");");
+
+			WriteLine("if (__thunk)");
+			Increment();
+			WriteLine("return MRKXCPPCallThunk<", ret, ">(__thunk, instance, ", sttic ? "true" : "false", ");");
+			Decrement();
+		}
+
+		mrks string invoke = concat("MRKRuntimeInvokeMethod(", methodExpr, ", instance, new void*[", method->ParamCount, "] { ", 
+			invokeStr, " }, ", sttic ? "true" : "false", ")");
+
+		if (ret.empty())
+			WriteLine("return ", invoke, ';');
+		else
+			WriteLine("return MRKXCPPUnbox<", ret, ">(", invoke, ");");
 
 		WriteLine("__end();");
 
 		Decrement();
 		WriteLine("}");
+
+		//System.String parameters also take UTF-8 text, which goes through the interned string cache
+		if (hasText) {
+			if (!typeParams.empty())
+				WriteLine("template<", typeParams, ">");
+
+			WriteLine("static ", retType, ' ', method->Name, "(", textParamStr, ") {");
+			Increment();
+			WriteLine("return ", method->Name, typeArgs.empty() ? "" : concat('<', typeArgs, '>'), "(", textForwardStr, ");");
+			Decrement();
+			WriteLine("}");
+
+			EmitCharOverload(typeParams, typeArgs, retType, method->Name, charParamStr, charForwardStr);
+		}
 	}
 
-	void MRKCodeWriter::WriteField(MRKXCPPField* field) {
-		WriteLine(concat("static void* m", Replace(field->Name, "`", "_gctx"), "(void* instance = 0) {"));
+	void MRKCodeWriter::EmitCharOverload(const mrks string& typeParams, const mrks string& typeArgs, const mrks string& retType, const mrks string& name,
+		const mrks string& params, const mrks string& forward) {
+		//a char* would pick the void* overload over std::string_view, this one only deduces for char so null still does
+		WriteLine("template<", typeParams, typeParams.empty() ? "" : ", ", "typename __C, MRKXCPPIfChar<__C> = 0>");
+		WriteLine("static ", retType, ' ', name, "(", params, ") {");
+		Increment();
+		WriteLine("return ", name, typeArgs.empty() ? "" : concat('<', typeArgs, '>'), "(", forward, ");");
+		Decrement();
+		WriteLine("}");
+	}
+
+	void MRKCodeWriter::EmitAsync(MRKXCPPMethod* method) {
+		//<Name>Async queues the call for the main thread. it runs in a later MRKXCPPPump, so primitives and value types
+		//are copied in while objects and byrefs are captured as they are and must stay alive until the future is ready.
+		//object results come back rooted in a handle, the worker may hold them across collections
+		mrks string typeParams;
+		mrks string typeArgs;
+		GetMethodTypeParams(method, typeParams, typeArgs);
+
+		mrks string paramStr;
+		mrks string captureStr;
+		mrks string forwardStr;
+		mrks string textParamStr;
+		mrks string textCaptureStr;
+		mrks string textForwardStr;
+		mrks string charParamStr;
+		mrks string charForwardStr;
+		bool hasText = false;
+		for (mrku32 i = 0; i < method->ParamCount; i++) {
+			mrks string param = GetParamType(method, i);
+			//byrefs stay pointers since the call writes through them
+			bool byref = method->Params[i][0] && method->Params[i][strlen(method->Params[i]) - 1] == '&';
+			mrks string value = param == "void*" || byref ? "" : GetNativeType(method->ParamTypes[i]);
+
+			concat_into(paramStr, param, " arg", i, ", ");
+			if (value.empty()) {
+				concat_into(captureStr, "arg", i, ", ");
+				concat_into(forwardStr, "arg", i, ", ");
+			}
+			else {
+				concat_into(captureStr, "__value", i, " = *(", value, "*)arg", i, ", ");
+				concat_into(forwardStr, "&__value", i, ", ");
+			}
+
+			//text is copied as well, it becomes a managed string on the main thread
+			if (!strcmp(method->Params[i], "System.String")) {
+				hasText = true;
+				concat_into(textParamStr, "std::string_view arg", i, ", ");
+				concat_into(textCaptureStr, "__text", i, " = std::string(arg", i, "), ");
+				concat_into(textForwardStr, "std::string_view(__text", i, "), ");
+				concat_into(charParamStr, "__C* arg", i, ", ");
+				concat_into(charForwardStr, "std::string_view(arg", i, "), ");
+			}
+			else {
+				concat_into(textParamStr, param, " arg", i, ", ");
+				concat_into(textCaptureStr, value.empty() ? concat("arg", i) : concat("__value", i, " = *(", value, "*)arg", i), ", ");
+				concat_into(textForwardStr, value.empty() ? concat("arg", i) : concat("&__value", i), ", ");
+				concat_into(charParamStr, param, " arg", i, ", ");
+				concat_into(charForwardStr, "arg", i, ", ");
+			}
+		}
+
+		mrks string ret = GetNativeType(method->ReturnType);
+		bool handle = ret.empty() && method->ReturnType.Kind != MRK_TYPE_VOID;
+		mrks string retType = handle ? "MRKXCPPHandle<void>" : ret.empty() ? "void*" : ret;
+		mrks string name = concat(method->Name, typeArgs.empty() ? "" : concat('<', typeArgs, '>'));
+
+		for (mrku32 text = 0; text < (hasText ? 2u : 1u); text++) {
+			if (!typeParams.empty())
+				WriteLine("template<", typeParams, ">");
+
+			WriteLine("static std::future<", retType, "> ", method->Name, "Async(", text ? textParamStr : paramStr, "void* instance = 0) {");
+			Increment();
+			mrks string call = concat(name, "(", text ? textForwardStr : forwardStr, "instance)");
+			if (handle)
+				call = concat(retType, "((void*)", call, ')');
+
+			WriteLine("return MRKXCPPDispatch([", text ? textCaptureStr : captureStr, "instance]() mutable { return ", call, "; });");
+			Decrement();
+			WriteLine("}");
+		}
+
+		if (hasText)
+			EmitCharOverload(typeParams, typeArgs, concat("std::future<", retType, '>'), concat(method->Name, "Async"),
+				concat(charParamStr, "void* instance = 0"), concat(charForwardStr, "instance"));
+	}
+
+	void MRKCodeWriter::EmitAsyncMethods(mrks vector<MRKXCPPMethod*>& methods) {
+		for (MRKXCPPMethod* method : methods) {
+			//a managed <Name>Async of the same shape keeps its name
+			mrks string async = concat(method->Name, "Async");
+			bool taken = false;
+			for (MRKXCPPMethod* other : m_CurrentStream->Methods)
+				taken |= async == other->Name && other->ParamCount == method->ParamCount;
+
+			if (!taken)
+				EmitAsync(method);
+		}
+	}
+
+	mrks string MRKCodeWriter::GetCallbackType(MRKXCPPType& type) {
+		//what the delegate marshals as, blittable values as themselves and everything else as an object pointer.
+		//bool marshals as a 4 byte BOOL and char as an ANSI char, value types holding either are laid out differently (empty)
+		if (type.Kind == MRK_TYPE_BOOLEAN)
+			return "int";
+
+		if (type.Kind == MRK_TYPE_CHAR)
+			return "char";
+
+		if (type.Kind == MRK_TYPE_VALUETYPE) {
+			for (mrku32 i = 0; i < type.FieldCount; i++) {
+				if (type.Fields[i].Kind == MRK_TYPE_BOOLEAN || type.Fields[i].Kind == MRK_TYPE_CHAR)
+					return "";
+			}
+		}
+
+		mrks string native = GetNativeType(type);
+		if (!native.empty())
+			return native;
+
+		return type.Kind == MRK_TYPE_VOID ? "void" : "void*";
+	}
+
+	void MRKCodeWriter::EmitDirectCall(const char* ptr, const mrks string& resolve, const mrks string& ret, const mrks string& sig, const mrks string& args) {
+		//a plain native call through a pointer resolved once, skipped when the runtime has none
+		mrks string call = concat("((", ret, "(MRK_XCPP_ICALLCALL*)(", sig, "))", ptr, ")(", args, ')');
+
+		WriteLine("static void* ", ptr, " = ", resolve, ';');
+		if (ret == "void") {
+			WriteLine("if (", ptr, ") {");
+			Increment();
+			WriteLine(call, ';');
+			WriteLine("return 0;");
+			Decrement();
+			WriteLine("}");
+		}
+		else {
+			WriteLine("if (", ptr, ")");
+			Increment();
+			WriteLine("return ", call, ';');
+			Decrement();
+		}
+	}
+
+	mrks string MRKCodeWriter::GetICallType(MRKXCPPType& type) {
+		//how an icall takes the type, empty when it would need marshaling (value types, byrefs, pointers, generics)
+		if (type.Name && type.Name[0] && type.Name[strlen(type.Name) - 1] == '&')
+			return "";
+
+		if (const char* primitive = GetPrimitiveType(type.Kind))
+			return primitive;
+
+		if (type.Kind == MRK_TYPE_VOID)
+			return "void";
+
+		return type.Kind != MRK_TYPE_PTR && IsReferenceKind(type.Kind) ? "void*" : "";
+	}
+
+	void MRKCodeWriter::EmitCallback(MRKXCPPMethod* invoke) {
+		mrks string sig = GetCallbackType(invoke->ReturnType);
+		if (sig.empty())
+			return;
+
+		sig += '(';
+		for (mrku32 i = 0; i < invoke->ParamCount; i++) {
+			mrks string param = GetCallbackType(invoke->ParamTypes[i]);
+			if (param.empty())
+				return;
+
+			concat_into(sig, i ? ", " : "", param);
+		}
+
+		sig += ')';
+
+		WriteLine("typedef MRKXCPPCallback<", Replace(m_CurrentStream->Class->Name, "`", "_gctx"), ", ", sig, "> __Callback;");
+	}
+
+	void MRKCodeWriter::EmitField(MRKXCPPField* field, const char* clazz) {
+		mrks string view = GetViewType(field->Type);
+
+		WriteLine("static ", view, " m", Replace(field->Name, "`", "_gctx"), "(void* instance = 0) {");
+		Increment();
+
+		WriteLine("__protect();");
+
+		WriteLine("return MRKRuntimeGetFieldValue(", clazz, ", E(\"", field->Name, "\"), instance);");
+
+		WriteLine("__end();");
+
+		Decrement();
+		WriteLine("}");
+	}
+
+	void MRKCodeWriter::EmitStaticField(MRKXCPPField* field, mrks string& storage, bool inflated) {
+		//a typed reference straight into the class' static data, the address never changes once resolved.
+		//slots holding object references are read only, a plain store would skip the GC write barrier
+		mrks string name = Replace(field->Name, "`", "_gctx");
+		bool writable = !IsReferenceKind(field->Type.Kind) && field->Type.Kind != MRK_TYPE_VAR;
+		for (mrku32 i = 0; i < field->Type.FieldCount; i++)
+			writable &= GetPrimitiveType(field->Type.Fields[i].Kind) != 0;
+
+		WriteLine("static ", writable ? "" : "const ", storage, "& m", name, "(void* instance = 0) {");
 		Increment();
 
 		WriteLine("__protect();");
 
-		WriteLine(concat("return MRKRuntimeGetFieldValue(__class, E(\"", field->Name, "\"), instance);"));
+		if (inflated) {
+			WriteLine("static ", storage, "* __addr = (", storage, "*)MRKRuntimeGetStaticFieldAddress(__inflated(), MRKRuntimeGetField(__inflated(), E(\"", field->Name, "\")));");
+			WriteLine("return MRKXCPPStaticField(__addr, E(\"", field->Name, "\"));");
+		}
+		else
+			WriteLine("return MRKXCPPStaticField(__sf_", name, ", E(\"", field->Name, "\"));");
 
 		WriteLine("__end();");
 
@@ -228,18 +871,166 @@ namespace MRK {
 		WriteLine("}");
 	}
 
+	mrku32 MRKCodeWriter::GetGenericArity(mrks string name) {
+		size_t tick = name.find('`');
+		if (tick == mrks string::npos)
+			return 0;
+
+		return (mrku32)atoi(name.c_str() + tick + 1);
+	}
+
+	void MRKCodeWriter::WriteMethod(MRKXCPPMethod* method, bool sttic) {
+		EmitMethod(method, sttic, "__class", m_CurrentStream->Methods.size());
+		m_CurrentStream->Methods.push_back(method);
+
+		//the delegate's own signature types its native callbacks, open generic delegates have none to offer
+		MRKXCPPClass* clazz = m_CurrentStream->Class;
+		if (clazz->Delegate && !strcmp(method->Name, "Invoke") && !GetGenericArity(clazz->Name) && !method->GenericParams)
+			EmitCallback(method);
+
+		if (GetGenericArity(m_CurrentStream->Class->Name))
+			m_CurrentStream->GenericMethods.push_back(mrks make_pair(method, sttic));
+	}
+
+	void MRKCodeWriter::WriteField(MRKXCPPField* field) {
+		//open generic classes have no static storage, their statics are only cached per instantiation
+		bool generic = GetGenericArity(m_CurrentStream->Class->Name);
+		mrks string storage = field->Static ? GetStorageType(field->Type) : "";
+
+		if (!storage.empty() && !generic) {
+			m_CurrentStream->StaticFields.push_back(mrks make_pair(field, storage));
+			WriteLine("static ", storage, "* __sf_", Replace(field->Name, "`", "_gctx"), ';');
+
+			EmitStaticField(field, storage, false);
+		}
+		else
+			EmitField(field, "__class");
+
+		if (generic)
+			m_CurrentStream->GenericFields.push_back(field);
+	}
+
+	void MRKCodeWriter::WriteGenericTemplate() {
+		//List`1 -> List_gctx1::of<T0>, bound to the inflated class which is resolved once per instantiation
+		mrku32 arity = GetGenericArity(m_CurrentStream->Class->Name);
+		m_Inflating = true;
+
+		mrks string typeParams;
+		mrks string typeArgs;
+		for (mrku32 i = 0; i < arity; i++) {
+			concat_into(typeParams, "typename T", i);
+			concat_into(typeArgs, 'T', i);
+
+			if (i < arity - 1) {
+				typeParams += ", ";
+				typeArgs += ", ";
+			}
+		}
+
+		WriteLine();
+		WriteLine("template<", typeParams, ">");
+		WriteLine("class of {");
+
+		WriteLine("public:");
+		Increment();
+
+		WriteLine("static void* __inflated() {");
+		Increment();
+		WriteLine("static void* clazz = MRKXCPPInflateClass<", typeArgs, ">(__class);");
+		WriteLine("return clazz;");
+		Decrement();
+		WriteLine("}");
+
+		Decrement();
+
+		WriteLine("public:");
+		Increment();
+
+		EmitCtor("__inflated()");
+
+		for (auto& method : m_CurrentStream->GenericMethods)
+			EmitMethod(method.first, method.second, "__inflated()", -1);
+
+		for (MRKXCPPField* field : m_CurrentStream->GenericFields) {
+			mrks string storage = field->Static ? GetStorageType(field->Type) : "";
+
+			if (!storage.empty())
+				EmitStaticField(field, storage, true);
+			else
+				EmitField(field, "__inflated()");
+		}
+
+		mrks vector<MRKXCPPMethod*> methods;
+		for (auto& method : m_CurrentStream->GenericMethods)
+			methods.push_back(method.first);
+
+		EmitAsyncMethods(methods);
+
+		Decrement();
+		WriteLine("};");
+
+		m_Inflating = false;
+	}
+
 	void MRKCodeWriter::CloseClass() {
+		EmitAsyncMethods(m_CurrentStream->Methods);
+
+		if (GetGenericArity(m_CurrentStream->Class->Name))
+			WriteGenericTemplate();
+
 		Decrement();
 		WriteLine("};");
 		Decrement();
 		WriteLine("}");
 
 		//x::y::__class = 0;
-		WriteLine(concat("inline void* ", Replace(m_CurrentStream->Class->Namespace, ".", "::"), 
-			"::", Replace(m_CurrentStream->Class->Name, "`", "_gctx"), "::__class = 0;"));
+		mrks string classPath = concat(Replace(m_CurrentStream->Class->Namespace, ".", "::"), 
+			"::", Replace(m_CurrentStream->Class->Name, "`", "_gctx"));
+
+		WriteLine("inline void* ", classPath, "::__class = 0;");
+		WriteLine("inline void* ", classPath, "::__methods[", mrks max<size_t>(m_CurrentStream->Methods.size(), 1), "] = {};");
+
+		for (auto& staticField : m_CurrentStream->StaticFields)
+			WriteLine("inline ", staticField.second, "* ", classPath, "::__sf_", Replace(staticField.first->Name, "`", "_gctx"), " = 0;");
+
+		m_InitializeStream << "#include \"" << Replace(m_CurrentStream->ClassPath.substr(m_ParentDir.size() + 1), MRK_PATH_SEP, "/") << "\"\n";
+
+		MRKXCPPClass* clazz = m_CurrentStream->Class;
+		mrku32 image = RegImage(clazz->Image);
+
+		m_InitializeBodyStream << "\t\t"
+			<< classPath
+			<< "::__class = MRKXCPPBindClass(__image" << image << ", " << FormatToken(clazz->Token) << ", E(\""
+			<< clazz->Namespace
+			<< "\"), E(\""
+			<< clazz->Name
+			<< "\"), E(\""
+			<< clazz->Image->Name
+			<< "\"));"
+			<< '\n';
+
+		for (mrku32 i = 0; i < m_CurrentStream->Methods.size(); i++) {
+			MRKXCPPMethod* method = m_CurrentStream->Methods[i];
+			m_InitializeBodyStream << "\t\t"
+				<< classPath << "::__methods[" << i << "] = MRKXCPPBindMethod(__image" << image << ", " << FormatToken(method->Token) << ", "
+				<< classPath << "::__class, E(\"" << method->Name << "\"), N(" << method->ParamCount << "), N(" << method->Occurance << "));\n";
+
+			//open generic definitions have no code of their own until inflated
+			if (!clazz->GenericParams && !method->GenericParams) {
+				m_WarmupBodyStream << "\t\tMRKXCPPWarmupMethod(E(\"" << clazz->Namespace << (*clazz->Namespace ? "." : "") << clazz->Name << "::" << method->Name << "\"), "
+					<< classPath << "::__methods[" << i << "], report, __stats);\n";
+			}
+		}
 
-		m_CodeClassPaths.push_back(Replace(m_CurrentStream->ClassPath.substr(m_ParentDir.size() + 1), "\\", "/"));
-		m_Images.push_back(m_CurrentStream->Class->Image->Name);
+		//static data only exists once the class is resolved, the runtime also runs its cctor
+		for (auto& staticField : m_CurrentStream->StaticFields) {
+			MRKXCPPField* field = staticField.first;
+			m_InitializeBodyStream << "\t\t"
+				<< classPath << "::__sf_" << Replace(field->Name, "`", "_gctx")
+				<< " = (" << staticField.second << "*)MRKRuntimeGetStaticFieldAddress("
+				<< classPath << "::__class, MRKXCPPBindField(__image" << image << ", " << FormatToken(field->Token) << ", "
+				<< classPath << "::__class, E(\"" << field->Name << "\")));\n";
+		}
 
 		m_CurrentStream->Stream.close();
 		m_OpenedStreams.erase(m_CurrentStream->ClassPath);
@@ -248,55 +1039,82 @@ namespace MRK {
 	}
 
 	void MRKCodeWriter::CloseWriter() {
-		m_InitializeStream << "//GENERATED BY MRK XCPP CODEGEN\n\n";
+		m_InitializeBodyStream.close();
 
-		m_InitializeStream << "#include \"MRKXCPPGen.h\"\n";
+		m_InitializeStream << "\nnamespace MRK {\n\tvoid MRK_XCPP_INIT() {\n";
 
-		for (mrks string& path : m_CodeClassPaths)
-			m_InitializeStream << "#include \"" << path << "\"\n";
+		mrks ifstream body(m_InitializeBodyPath, mrks ios_base::in);
+		if (body.peek() != mrks ifstream::traits_type::eof())
+			m_InitializeStream << body.rdbuf();
 
-		m_InitializeStream << "\nnamespace MRK {\n\tvoid MRK_XCPP_INIT() {\n";
+		body.close();
+		mrksfs remove(m_InitializeBodyPath);
 
-		for (mrks string& path : m_CodeClassPaths) {
-			mrks string cpC = Replace(Replace(path, ".hpp", ""), "/", "::"); //x::y
-			mrku32 spLast = cpC.find_last_of("::");
-			mrks string monoNms = Replace(cpC.substr(0, spLast - 1), "::", ".");
-			mrks string monoClass = Replace(cpC.substr(spLast + 1), "_gctx", "`");
+		//compile everything bound right away instead of on first call
+		m_InitializeStream << "\n#ifdef MRK_XCPP_WARMUP_ON_INIT\n\t\tMRK_XCPP_WARMUP(0);\n#endif\n";
+		m_InitializeStream << "\t}\n\n\tMRKXCPPWarmupStats MRK_XCPP_WARMUP(MRKXCPPWarmupReport report) {\n\t\tMRKXCPPWarmupStats __stats{};\n";
 
-			m_InitializeStream << "\t\t"
-				<< cpC
-				<< "::__class = MRKRuntimeGetClass(E(\""
-				<< monoNms
-				<< "\"), E(\""
-				<< monoClass
-				<< "\"), E(\""
-				<< m_Images.front()
-				<< "\"));"
-				<< '\n';
+		m_WarmupBodyStream.close();
 
-			m_Images.erase(m_Images.begin());
-		}
+		mrks ifstream warmup(m_WarmupBodyPath, mrks ios_base::in);
+		if (warmup.peek() != mrks ifstream::traits_type::eof())
+			m_InitializeStream << warmup.rdbuf();
 
-		m_InitializeStream << "\t}\n}";
+		warmup.close();
+		mrksfs remove(m_WarmupBodyPath);
+
+		m_InitializeStream << "\t\treturn __stats;\n\t}\n}";
 
 		m_InitializeStream.close();
 
-		m_InitializeStream = mrks ofstream(concat(m_ParentDir, "\\MRKXCPPInit.h"), mrks ios_base::out);
+		m_InitializeStream = mrks ofstream(concat(m_ParentDir, MRK_PATH_SEP "MRKXCPPInit.h"), mrks ios_base::out);
 		m_InitializeStream << "//GENERATED BY MRK XCPP CODEGEN\n\n"
 			<< "#pragma once\n\n"
+			<< "#include \"MRKXCPPRuntime.h\"\n\n"
 			<< "namespace MRK {\n"
 			<< "\t void MRK_XCPP_INIT();\n"
+			<< "\t MRKXCPPWarmupStats MRK_XCPP_WARMUP(MRKXCPPWarmupReport report = 0);\n"
 			<< "}";
 
 		m_InitializeStream.close();
 
-		m_InitializeStream = mrks ofstream(concat(m_ParentDir, "\\MRKXCPPTypes.h"), mrks ios_base::out);
+		m_InitializeStream = mrks ofstream(concat(m_ParentDir, MRK_PATH_SEP "MRKXCPPTypes.h"), mrks ios_base::out);
 		m_InitializeStream << "//GENERATED BY MRK XCPP CODEGEN\n\n"
-			<< "#pragma once\n\n";
+			<< "#pragma once\n\n"
+			<< "#include <cstdint>\n\n";
 
 		for (mrks string& regParam : m_RegParams)
 			m_InitializeStream << "typedef void* " << regParam << ";\n";
 
+		//explicit padding mirrors the managed offsets, packing keeps the compiler from adding its own
+		if (m_ValueTypeDefs.size()) {
+			m_InitializeStream << "\n#pragma pack(push, 1)\n";
+
+			for (mrks string& def : m_ValueTypeDefs)
+				m_InitializeStream << '\n' << def;
+
+			m_InitializeStream << "\n#pragma pack(pop)\n";
+		}
+
 		m_InitializeStream.close();
+
+		//every generated header includes the runtime, it ships next to the module or is taken from the tree the module was built from
+		mrks string runtimeDst = concat(m_ParentDir, MRK_PATH_SEP "MRKXCPPRuntime.h");
+		mrks string runtimeSrcs[] = {
+			concat(m_ParentDir.substr(0, m_ParentDir.find_last_of(MRK_PATH_SEP)), MRK_PATH_SEP "MRKXCPPRuntime.h"),
+			mrksfs path(__FILE__).replace_filename("MRKXCPPRuntime.h").string()
+		};
+
+		bool copied = false;
+		for (mrks string& runtimeSrc : runtimeSrcs) {
+			mrks error_code ec;
+			if (mrksfs is_regular_file(runtimeSrc, ec) && mrksfs copy_file(runtimeSrc, runtimeDst, mrksfs copy_options::overwrite_existing, ec)) {
+				copied = true;
+				break;
+			}
+		}
+
+		if (!copied)
+			MRKLog("Unable to find MRKXCPPRuntime.h, copy it next to MRKXCPPGen.h before building the generated code");
 	}
 }
@@ -29,10 +29,14 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 
 #include "MRKCommon.h"
 #include "MRKXCPPStructs.h"
+#include "Concat.hpp"
+
+#define MRK_XCPP_GENERIC_PARAM_NONE ((mrku32)-1)
 
 namespace MRK {
 	struct MRKCodeStream {
@@ -41,6 +45,10 @@ namespace MRK {
 		bool IsDirty;
 		mrks string ClassPath;
 		MRKXCPPClass* Class;
+		mrks vector<mrks pair<MRKXCPPMethod*, bool>> GenericMethods;
+		mrks vector<MRKXCPPField*> GenericFields;
+		mrks vector<mrks pair<MRKXCPPField*, mrks string>> StaticFields; //field, storage type
+		mrks vector<MRKXCPPMethod*> Methods; //__methods slot order
 	};
 
 	class MRKCodeWriter {
@@ -49,20 +57,65 @@ namespace MRK {
 		MRKCodeStream* m_CurrentStream;
 		mrks string m_ParentDir;
 		mrks ofstream m_InitializeStream;
-		mrks vector<mrks string> m_CodeClassPaths;
+		mrks ofstream m_InitializeBodyStream;
+		mrks string m_InitializeBodyPath;
+		mrks ofstream m_WarmupBodyStream;
+		mrks string m_WarmupBodyPath;
 		mrks vector<mrks string> m_RegParams;
-		mrks vector<mrks string> m_Images;
+		mrks vector<mrks string> m_RegValueTypes;
+		mrks vector<mrks string> m_ValueTypeDefs;
+		mrks vector<MRKXCPPImage*> m_RegImages;
+		mrks set<mrks string> m_BoundClasses; //"Namespace.Name" of every class that will be generated
+		mrks string m_LineBuffer;
+		bool m_Inflating;
+
+		//formats straight into m_LineBuffer, which keeps its capacity across lines
+		template<typename... Args>
+		void WriteLine(const Args&... args) {
+			m_LineBuffer.assign(sizeof...(Args) ? m_CurrentStream->IndentCount : 0, '\t');
+			concat_into(m_LineBuffer, args..., '\n');
+			m_CurrentStream->Stream.write(m_LineBuffer.data(), m_LineBuffer.size());
+		}
 
-		void WriteLine(mrks string line);
 		mrks string Replicate(char c, mrku32 times);
 		mrks string Replicate(mrks string c, mrku32 times);
 		void Increment();
 		void Decrement();
 		mrks string Replace(mrks string orig, mrks string from, mrks string to);
 		void RegParam(mrks string& param);
+		mrku32 GetGenericArity(mrks string name);
+		//MRK_XCPP_GENERIC_PARAM_NONE when name is not a generic parameter of the current class
+		mrku32 GetGenericParamIndex(mrks string name);
+		const char* GetPrimitiveType(mrku32 kind);
+		mrku32 GetPrimitiveSize(mrku32 kind);
+		bool IsReferenceKind(mrku32 kind);
+		mrks string GetNativeType(MRKXCPPType& type);
+		mrks string GetStorageType(MRKXCPPType& type);
+		mrks string GetViewType(MRKXCPPType& type);
+		void RegValueType(mrks string& name, MRKXCPPType& type);
+		mrku32 RegImage(MRKXCPPImage* image);
+		mrks string FormatToken(mrku32 token);
+		void EmitCtor(const char* clazz);
+		void GetMethodTypeParams(MRKXCPPMethod* method, mrks string& typeParams, mrks string& typeArgs);
+		mrks string GetParamType(MRKXCPPMethod* method, mrku32 idx);
+		void EmitMethod(MRKXCPPMethod* method, bool sttic, const char* clazz, int slot);
+		void EmitCharOverload(const mrks string& typeParams, const mrks string& typeArgs, const mrks string& retType, const mrks string& name,
+			const mrks string& params, const mrks string& forward);
+		void EmitAsync(MRKXCPPMethod* method);
+		void EmitAsyncMethods(mrks vector<MRKXCPPMethod*>& methods);
+		mrks string GetCallbackType(MRKXCPPType& type);
+		mrks string GetICallType(MRKXCPPType& type);
+		void EmitDirectCall(const char* ptr, const mrks string& resolve, const mrks string& ret, const mrks string& sig, const mrks string& args);
+		void EmitCallback(MRKXCPPMethod* invoke);
+		void EmitField(MRKXCPPField* field, const char* clazz);
+		void EmitStaticField(MRKXCPPField* field, mrks string& storage, bool inflated);
+		void WriteGenericTemplate();
+		mrks string GetBaseClass(MRKXCPPClass* clazz);
 
 	public:
 		MRKCodeWriter(mrks string dir);
+		void RegClass(const char* namespaze, const char* name);
+		bool IsInheritedMethod(MRKXCPPMethod* method);
 		void OpenClass(MRKXCPPClass* clazz);
 		void WriteMethod(MRKXCPPMethod* method, bool sttic);
 		void WriteField(MRKXCPPField* field);
@@ -26,14 +26,33 @@
 
 #pragma once
 
+#include <algorithm>
+
 #define mrks ::std::
 #define mrksfs mrks filesystem::
 #define mrku16 unsigned short
 #define mrku32 unsigned int
 #define mrku32ptr unsigned long long
 
+#ifdef _WIN32
+#define MRK_PATH_SEP "\\"
+#else
+#define MRK_PATH_SEP "/"
+#endif
+
 #define MRK_VEC_CONTAIN(vector, element) mrks find(vector.begin(), vector.end(), element) != vector.end()
 
 #define MRK_XCPP_MONO
-#define MONO_FUNCTION_COUNT 23
-#define MONO_MODULE_NAME "mono-2.0-bdwgc.dll"
\ No newline at end of file
+#define MRK_XCPP_IL2CPP
+
+#ifdef _WIN32
+#define MONO_MODULE_NAME "mono-2.0-bdwgc.dll"
+#else
+#define MONO_MODULE_NAME "libmonosgen-2.0.so"
+#endif
+
+#ifdef _WIN32
+#define IL2CPP_MODULE_NAME "GameAssembly.dll"
+#else
+#define IL2CPP_MODULE_NAME "GameAssembly.so"
+#endif
\ No newline at end of file
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "MRKCommon.h"
+#include "MRKAlloc.hpp"
+
+#define MRK_CACHE_BUCKET_COUNT 1024
+#define MRK_CACHE_READER_SHARDS 64
+
+namespace MRK {
+	inline mrku32ptr MRKHashBytes(mrku32ptr hash, const void* data, size_t sz) {
+		for (size_t i = 0; i < sz; i++) {
+			hash ^= ((const unsigned char*)data)[i];
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	inline mrku32ptr MRKHashString(mrku32ptr hash, const char* str) {
+		for (; str && *str; str++) {
+			hash ^= (unsigned char)*str;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	//reader counter of the calling thread, threads spread over the shards so concurrent readers rarely share a cache line
+	inline mrku32 MRKCacheReaderShard() {
+		static mrks atomic<mrku32> next(0);
+		static thread_local mrku32 shard = next.fetch_add(1, mrks memory_order_relaxed) % MRK_CACHE_READER_SHARDS;
+		return shard;
+	}
+
+	//read-mostly hash map of T*: readers never lock, writers serialize on one mutex and publish a fully built node with a release store.
+	//removed nodes and their values are only released after a grace period, a reader that raced with the removal can still walk
+	//past them and run its predicate on the value. readers count themselves under the current epoch parity, a writer flips the
+	//parity and frees what was removed before the flip once the readers of the previous parity are gone
+	template<typename T>
+	class MRKConcurrentCache {
+		struct Node {
+			mrku32ptr Hash;
+			T* Value;
+			mrks atomic<Node*> Next;
+		};
+
+		struct alignas(64) ReaderShard {
+			mrks atomic<mrku32> Count[2]; //per epoch parity
+		};
+
+		mrks atomic<Node*> m_Buckets[MRK_CACHE_BUCKET_COUNT];
+		ReaderShard m_Readers[MRK_CACHE_READER_SHARDS];
+		mrks atomic<mrku32> m_Epoch;
+		mrks vector<Node*> m_Retired; //removed since the last flip
+		mrks vector<Node*> m_Waiting; //removed before the last flip, only readers of the previous parity can reach them
+		mrks mutex m_WriteLock;
+		void (*m_Release)(T*);
+
+		struct ReadScope {
+			mrks atomic<mrku32>* Readers;
+
+			ReadScope(ReaderShard* readers, mrks atomic<mrku32>& epoch) {
+				ReaderShard& shard = readers[MRKCacheReaderShard()];
+
+				//a flip between reading the parity and counting under it would go unnoticed by the writer
+				for (;;) {
+					mrku32 parity = epoch.load();
+					Readers = &shard.Count[parity];
+					Readers->fetch_add(1);
+
+					if (epoch.load() == parity)
+						break;
+
+					Readers->fetch_sub(1);
+				}
+			}
+
+			~ReadScope() {
+				Readers->fetch_sub(1);
+			}
+		};
+
+		bool HasReaders(mrku32 parity) {
+			for (ReaderShard& shard : m_Readers) {
+				if (shard.Count[parity].load())
+					return true;
+			}
+
+			return false;
+		}
+
+		//nodes and the fixed bucket and reader arrays count towards the allocation report, the retire lists do not
+		Node* NewNode() {
+			MRKAllocTrack(MRK_ALLOC_CACHE, sizeof(Node));
+			return new Node;
+		}
+
+		void FreeNode(Node* node) {
+			MRKAllocUntrack(MRK_ALLOC_CACHE, sizeof(Node));
+			delete node;
+		}
+
+		void Delete(Node* node) {
+			if (m_Release)
+				m_Release(node->Value);
+
+			FreeNode(node);
+		}
+
+		template<typename Pred>
+		T* FindUnscoped(mrku32ptr hash, Pred pred) {
+			//seq_cst so a reader that entered after Reclaim saw no readers can not observe an unlinked node (x86 loads stay plain)
+			Node* node = m_Buckets[hash % MRK_CACHE_BUCKET_COUNT].load();
+			for (; node; node = node->Next.load()) {
+				if (node->Hash == hash && pred(node->Value))
+					return node->Value;
+			}
+
+			return 0;
+		}
+
+		void Reclaim() {
+			//writer lock held, a second pass frees right away what the flip of the first one retired when nobody was reading
+			for (int pass = 0; pass < 2; pass++) {
+				mrku32 epoch = m_Epoch.load(mrks memory_order_relaxed);
+				if (!m_Waiting.empty()) {
+					if (HasReaders(!epoch))
+						return;
+
+					for (Node* node : m_Waiting)
+						Delete(node);
+
+					m_Waiting.clear();
+				}
+
+				if (m_Retired.empty())
+					return;
+
+				//readers entering from now on count under the new parity and can not reach anything unlinked before
+				m_Waiting.swap(m_Retired);
+				m_Epoch.store(!epoch);
+			}
+		}
+
+	public:
+		//release frees a removed value, 0 leaves it to whoever called RemoveIf
+		MRKConcurrentCache(void (*release)(T*) = 0) : m_Buckets(), m_Readers(), m_Epoch(0), m_Release(release) {
+			MRKAllocTrack(MRK_ALLOC_CACHE, sizeof(m_Buckets) + sizeof(m_Readers));
+		}
+
+		~MRKConcurrentCache() {
+			MRKAllocUntrack(MRK_ALLOC_CACHE, sizeof(m_Buckets) + sizeof(m_Readers));
+
+			for (mrks atomic<Node*>& bucket : m_Buckets) {
+				Node* node = bucket.load();
+				while (node) {
+					Node* next = node->Next.load();
+					FreeNode(node);
+					node = next;
+				}
+			}
+
+			for (Node* node : m_Retired)
+				Delete(node);
+
+			for (Node* node : m_Waiting)
+				Delete(node);
+		}
+
+		template<typename Pred>
+		T* Find(mrku32ptr hash, Pred pred) {
+			ReadScope scope(m_Readers, m_Epoch);
+			return FindUnscoped(hash, pred);
+		}
+
+		//lock-free hit, on a miss resolve runs under the writer lock so a value is never resolved twice
+		template<typename Pred, typename Resolve>
+		T* FindOrAdd(mrku32ptr hash, Pred pred, Resolve resolve) {
+			T* value = Find(hash, pred);
+			if (value)
+				return value;
+
+			mrks lock_guard<mrks mutex> lock(m_WriteLock);
+
+			value = FindUnscoped(hash, pred);
+			if (value)
+				return value;
+
+			value = resolve();
+			if (!value)
+				return 0;
+
+			mrks atomic<Node*>& bucket = m_Buckets[hash % MRK_CACHE_BUCKET_COUNT];
+
+			Node* node = NewNode();
+			node->Hash = hash;
+			node->Value = value;
+			node->Next.store(bucket.load(mrks memory_order_relaxed), mrks memory_order_relaxed);
+			bucket.store(node, mrks memory_order_release);
+
+			Reclaim();
+			return value;
+		}
+
+		//unlinks every value matching pred, they are released with their nodes once no reader can reach them
+		template<typename Pred>
+		void RemoveIf(Pred pred) {
+			mrks lock_guard<mrks mutex> lock(m_WriteLock);
+
+			for (mrks atomic<Node*>& bucket : m_Buckets) {
+				mrks atomic<Node*>* link = &bucket;
+
+				Node* node = link->load(mrks memory_order_relaxed);
+				while (node) {
+					Node* next = node->Next.load(mrks memory_order_relaxed);
+
+					if (pred(node->Value)) {
+						link->store(next);
+						m_Retired.push_back(node);
+					}
+					else
+						link = &node->Next;
+
+					node = next;
+				}
+			}
+
+			Reclaim();
+		}
+	};
+}
@@ -36,7 +36,7 @@ namespace MRK {
 	}
 
 	void MRKLog(mrks string log, bool clear, bool sep) {
-		_STD ofstream stream(ms_LogPath.c_str(), clear ? mrks ios_base::out : mrks ios_base::app);
+		mrks ofstream stream(ms_LogPath.c_str(), clear ? mrks ios_base::out : mrks ios_base::app);
 		if (sep)
 			stream << '\n';
 
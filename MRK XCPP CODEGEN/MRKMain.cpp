@@ -24,18 +24,26 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
+
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <set>
+#include <cstdlib>
 
 #include "MRKCommon.h"
 #include "Concat.hpp"
 #include "MRKLog.h"
 #include "MRKAlloc.hpp"
+#include "MRKModule.h"
 #include "MRKXCPPBackend.h"
 #include "MRKXCPP.h"
 #include "MRKCodeWriter.h"
+#include "MRKUsage.h"
 
 namespace MRK {
 	struct MRKGenDataMethod {
@@ -61,6 +69,12 @@ namespace MRK {
 		mrks vector<MRKGenDataClass> Classes;
 	};
 
+	//binds every public class, method and field of an image whose namespace starts with NamespaceFilter
+	struct MRKGenDataImage {
+		mrks string Name;
+		mrks string NamespaceFilter;
+	};
+
 #define GEN_CLASS(nms, name) MRKGenDataClass { #nms, #name, {
 #define GEN_CLASS_END } }
 
@@ -377,48 +391,323 @@ namespace MRK {
 		}
 	};
 
-	void Init() {
-		char __path[MAX_PATH];
-		mrks string spath(__path, GetModuleFileNameA(0, __path, MAX_PATH));
+#ifdef MRK_GEN_WHOLE_IMAGE
 
-		spath = concat(spath.substr(0, spath.find_last_of('\\')), "\\MRK CGEN Log.txt");
-		MRKSetLogPath(spath);
+	mrks vector<MRKGenDataImage> ms_GenImages = {
+		MRKGenDataImage { "Assembly-CSharp", "EFT" }
+	};
 
-		MRKLog("MRK XCPP CODEGEN - v1\n", true, false);
+#else
+
+	mrks vector<MRKGenDataImage> ms_GenImages;
+
+#endif
+
+#ifdef MRK_GEN_PRUNE
+
+	//consumer source trees or symbol listings next to the codegen, only what they reference is generated (see MRKUsage.h)
+	mrks vector<mrks string> ms_UsagePaths = {
+		"MRK CGEN Usage"
+	};
 
-#ifdef MRK_XCPP_MONO
-		MRKLog("Initializing Mono backend");
 #else
-		MRKLog("Initializing XCPP backend");
+
+	mrks vector<mrks string> ms_UsagePaths;
+
 #endif
 
-		if (!MRKXCPPBackendInit(MONO_MODULE_NAME)) {
-			MRKLog("Unable to initialize XCPP backend");
+	mrku32 ms_PrunedClasses = 0;
+	mrku32 ms_PrunedMembers = 0;
+
+	mrks string GetBindingName(const char* name) {
+		//the identifier the writer emits for a class or member, List`1 -> List_gctx1
+		mrks string binding = name;
+		for (size_t pos; (pos = binding.find('`')) != mrks string::npos;)
+			binding.replace(pos, 1, "_gctx");
+
+		return binding;
+	}
+
+	bool IsUsedClass(const char* name) {
+		if (MRKUsageHasClass(GetBindingName(name).c_str()))
+			return true;
+
+		ms_PrunedClasses++;
+		return false;
+	}
+
+	bool IsUsedMember(const char* name, bool field) {
+		//fields are read through m<Name>, methods may only be queued through <Name>Async
+		mrks string binding = GetBindingName(name);
+		if (MRKUsageHasMember(concat(field ? "m" : "", binding).c_str()) || (!field && MRKUsageHasMember(concat(binding, "Async").c_str())))
+			return true;
+
+		ms_PrunedMembers++;
+		return false;
+	}
+
+	void MarkUsedParents(MRKXCPPClass* clazz) {
+		//a used class includes its bound bases' headers, so those stay too
+		if (!clazz || !clazz->Parents)
+			return;
+
+		mrks string parents = concat(clazz->Parents, ',');
+		for (size_t start = 0, end; (end = parents.find(',', start)) != mrks string::npos; start = end + 1) {
+			mrks string parent = parents.substr(start, end - start);
+			MRKUsageAddClass(GetBindingName(parent.substr(parent.find_last_of('.') + 1).c_str()).c_str());
+		}
+	}
+
+	bool IsBindableName(const char* name) {
+		//skips compiler generated and special names (<Module>, .ctor, <>c__DisplayClass...)
+		if (!name || !(isalpha((unsigned char)name[0]) || name[0] == '_'))
+			return false;
+
+		for (const char* c = name; *c; c++) {
+			if (!(isalnum((unsigned char)*c) || *c == '_' || *c == '`'))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool IsGeneratedClass(MRKXCPPMemberInfo& classInfo, MRKGenDataImage& genImage) {
+		if (!classInfo.Public)
+			return false;
+
+		//global namespace types can not be expressed in the generated namespace layout
+		if (!classInfo.Namespace || !strlen(classInfo.Namespace) || !IsBindableName(classInfo.Name))
+			return false;
+
+		if (mrks string(classInfo.Namespace).rfind(genImage.NamespaceFilter, 0) != 0)
+			return false;
+
+		//classes in ms_GenAssemblies are generated from their hand written list, a second pass would reopen their header
+		for (MRKGenDataAssembly& assembly : ms_GenAssemblies) {
+			if (assembly.Name != genImage.Name)
+				continue;
+
+			for (MRKGenDataClass& clazz : assembly.Classes) {
+				if (clazz.Namespace == classInfo.Namespace && clazz.Name == classInfo.Name)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	void MarkImageParents(MRKGenDataImage& genImage) {
+		//has to run before RegisterImage, a base may come before the classes deriving from it
+		MRKXCPPImage* _image = MRKXCPPGetImage(genImage.Name.c_str());
+		if (!_image)
+			return;
+
+		mrku32 classCount = MRKXCPPBackendGetClassCount(_image);
+		for (mrku32 idx = 0; idx < classCount; idx++) {
+			MRKXCPPMemberInfo classInfo;
+			if (!MRKXCPPBackendGetClassInfo(_image, idx, &classInfo) || !IsGeneratedClass(classInfo, genImage)
+				|| !MRKUsageHasClass(GetBindingName(classInfo.Name).c_str()))
+				continue;
+
+			MRKXCPPClass* _class = MRKXCPPGetClass(_image, classInfo.Namespace, classInfo.Name);
+			MarkUsedParents(_class);
+
+			if (_class)
+				MRKXCPPReleaseClass(_class);
+		}
+	}
+
+	void RegisterImage(MRKCodeWriter& codeWriter, MRKGenDataImage& genImage) {
+		//names only, nothing is resolved until GenerateImage streams the image
+		MRKXCPPImage* _image = MRKXCPPGetImage(genImage.Name.c_str());
+		if (!_image)
 			return;
+
+		mrku32 classCount = MRKXCPPBackendGetClassCount(_image);
+		for (mrku32 idx = 0; idx < classCount; idx++) {
+			MRKXCPPMemberInfo classInfo;
+			if (MRKXCPPBackendGetClassInfo(_image, idx, &classInfo) && IsGeneratedClass(classInfo, genImage)
+				&& MRKUsageHasClass(GetBindingName(classInfo.Name).c_str()))
+				codeWriter.RegClass(classInfo.Namespace, classInfo.Name);
+		}
+	}
+
+	//a method of the class being enumerated, by name and argc
+	struct MRKMethodKey {
+		mrks string_view Name;
+		mrku32 ParamCount;
+
+		bool operator==(const MRKMethodKey& other) const {
+			return ParamCount == other.ParamCount && Name == other.Name;
+		}
+	};
+
+	void GenerateImage(MRKCodeWriter& codeWriter, MRKGenDataImage& genImage) {
+		MRKXCPPImage* _image = MRKXCPPGetImage(genImage.Name.c_str());
+		if (!_image) {
+			MRKLog(concat("IMAGE NULL -> ", genImage.Name));
+			return;
+		}
+
+		mrku32 classCount = MRKXCPPBackendGetClassCount(_image);
+		MRKLog(concat("Streaming ", classCount, " types from ", genImage.Name));
+
+		mrku32 generated = 0;
+		mrks vector<MRKMethodKey> boundMethods;
+		mrks vector<MRKMethodKey> seenMethods;
+
+		for (mrku32 idx = 0; idx < classCount; idx++) {
+			MRKXCPPMemberInfo classInfo;
+			if (!MRKXCPPBackendGetClassInfo(_image, idx, &classInfo) || !IsGeneratedClass(classInfo, genImage)
+				|| !IsUsedClass(classInfo.Name))
+				continue;
+
+			MRKXCPPClass* _class = MRKXCPPGetClass(_image, classInfo.Namespace, classInfo.Name);
+			if (!_class) {
+				MRKLog(concat("CLASS NULL -> ", classInfo.Name));
+				continue;
+			}
+
+			codeWriter.OpenClass(_class);
+
+			boundMethods.clear();
+			seenMethods.clear();
+
+			void* iter = 0;
+			MRKXCPPMemberInfo info;
+			while (MRKXCPPBackendNextMethod(_class, &iter, &info)) {
+				//overloads are told apart by their position among same name and argc methods, in metadata order
+				//names are the runtime's own strings, which outlive the class' enumeration
+				MRKMethodKey key{ info.Name, info.ParamCount };
+				int occ = 1 + (int)mrks count(seenMethods.begin(), seenMethods.end(), key);
+				seenMethods.push_back(key);
+
+				if (!info.Public || !IsBindableName(info.Name) || !IsUsedMember(info.Name, false))
+					continue;
+
+				//same name and argc overloads collapse into one C++ signature, only the first is bound.
+				//a generic method is a template and coexists with a plain overload of the same shape
+				MRKMethodKey boundKey{ info.Name, info.ParamCount | ((mrku32)(info.GenericArity != 0) << 31) };
+				if (MRK_VEC_CONTAIN(boundMethods, boundKey)) {
+					MRKLog(concat("OVERLOAD SKIPPED -> ", classInfo.Name, "::", info.Name));
+					continue;
+				}
+
+				boundMethods.push_back(boundKey);
+
+				MRKXCPPMethod* _method = MRKXCPPGetMethod(_class, info.Name, info.ParamCount, occ);
+				if (!_method) {
+					MRKLog(concat("METHOD NULL -> ", info.Name));
+					continue;
+				}
+
+				codeWriter.WriteMethod(_method, info.Static);
+			}
+
+			iter = 0;
+			while (MRKXCPPBackendNextField(_class, &iter, &info)) {
+				if (!info.Public || !IsBindableName(info.Name) || !IsUsedMember(info.Name, true))
+					continue;
+
+				MRKXCPPField* _field = MRKXCPPGetField(_class, info.Name);
+				if (!_field) {
+					MRKLog(concat("FIELD NULL -> ", info.Name));
+					continue;
+				}
+
+				codeWriter.WriteField(_field);
+			}
+
+			codeWriter.CloseClass();
+
+			//nothing resolved for this class is needed again, keep peak memory flat
+			MRKXCPPReleaseClass(_class);
+			generated++;
 		}
 
-		MRKLog("Successfully initialized XCPP backend");
+		MRKLog(concat("Generated ", generated, " types from ", genImage.Name));
+	}
+
+	void Init() {
+		//an executable build also runs the load constructor before main
+		static bool initialized = false;
+		if (initialized)
+			return;
+
+		initialized = true;
 
-		mrku32 ptrsSz;
-		void*** ptrs = MRKXCPPBackendGetPointers(&ptrsSz);
+		mrks string spath = MRKModuleGetHostPath();
 
-		MRKLog("XCPP backend pointers:");
+		spath = concat(spath.substr(0, spath.find_last_of(MRK_PATH_SEP)), MRK_PATH_SEP "MRK CGEN Log.txt");
+		MRKSetLogPath(spath);
+
+		MRKLog("MRK XCPP CODEGEN - v1\n", true, false);
 
-		for (mrku32 idx = 0; idx < ptrsSz; idx++) {
-			MRKLog(concat('\t', *(ptrs[idx])));
+		MRKLog("Initializing XCPP backend");
+
+		//whichever runtime hosts us unless MRK_XCPP_BACKEND names one (Mono, IL2CPP)
+		if (!MRKXCPPBackendInit(getenv("MRK_XCPP_BACKEND"))) {
+			MRKLog("Unable to initialize XCPP backend");
+			return;
 		}
 
-		spath = concat(spath.substr(0, spath.find_last_of('\\')), "\\MRK CGEN");
+		MRKLog(concat("Successfully initialized XCPP backend (", MRKXCPPBackendGetName(), ')'));
+
+		spath = concat(spath.substr(0, spath.find_last_of(MRK_PATH_SEP)), MRK_PATH_SEP "MRK CGEN");
 		if (!mrksfs is_directory(spath))
 			mrksfs create_directory(spath);
 
 		MRKCodeWriter codeWriter(spath);
 
+		mrks string moduleDir = spath.substr(0, spath.find_last_of(MRK_PATH_SEP));
+		for (mrks string& usagePath : ms_UsagePaths) {
+			mrks string path = concat(moduleDir, MRK_PATH_SEP, usagePath);
+			MRKLog(concat("Usage: read ", MRKUsageScan(path.c_str()), " files from ", path));
+		}
+
+		if (ms_UsagePaths.size() && !MRKUsageIsActive())
+			MRKLog("Usage: no sources found, pruning is off and every binding is generated");
+
+		if (MRKUsageIsActive()) {
+			for (MRKGenDataAssembly& assembly : ms_GenAssemblies) {
+				for (MRKGenDataClass& clazz : assembly.Classes) {
+					if (MRKUsageHasClass(GetBindingName(clazz.Name.c_str()).c_str()))
+						MarkUsedParents(MRKXCPPGetClass(MRKXCPPGetImage(assembly.Name.c_str()), clazz.Namespace.c_str(), clazz.Name.c_str()));
+				}
+			}
+
+			for (MRKGenDataImage& genImage : ms_GenImages)
+				MarkImageParents(genImage);
+		}
+
+		//every bound class and method up front, a class derives from its nearest bound ancestor
+		//and leaves the methods that ancestor declares and binds to it
+		mrks set<mrks string> boundMethods;
+		for (MRKGenDataAssembly& assembly : ms_GenAssemblies) {
+			for (MRKGenDataClass& clazz : assembly.Classes) {
+				if (!MRKUsageHasClass(GetBindingName(clazz.Name.c_str()).c_str()))
+					continue;
+
+				codeWriter.RegClass(clazz.Namespace.c_str(), clazz.Name.c_str());
+
+				for (MRKGenDataMethod& method : clazz.Methods) {
+					if (MRKUsageHasMember(method.Name.c_str()))
+						boundMethods.insert(concat(clazz.Namespace, '.', clazz.Name, "::", method.Name, '/', method.ParamCount));
+				}
+			}
+		}
+
+		for (MRKGenDataImage& genImage : ms_GenImages)
+			RegisterImage(codeWriter, genImage);
+
 		for (MRKGenDataAssembly& assembly : ms_GenAssemblies) {
 			MRKLog("XXX");
 			MRKXCPPImage* _image = MRKXCPPGetImage(assembly.Name.c_str());
 
 			for (MRKGenDataClass& clazz : assembly.Classes) {
+				if (!IsUsedClass(clazz.Name.c_str()))
+					continue;
+
 				MRKXCPPClass* _class = MRKXCPPGetClass(_image, clazz.Namespace.c_str(), clazz.Name.c_str());
 				if (!_class) {
 					MRKLog(concat("CLASS NULL -> ", clazz.Name));
@@ -428,16 +717,27 @@ namespace MRK {
 				codeWriter.OpenClass(_class);
 
 				for (MRKGenDataMethod& method : clazz.Methods) {
+					if (!IsUsedMember(method.Name.c_str(), false))
+						continue;
+
 					MRKXCPPMethod* _method = MRKXCPPGetMethod(_class, method.Name.c_str(), method.ParamCount, method.Occurance);
 					if (!_method) {
 						MRKLog(concat("METHOD NULL -> ", method.Name));
 						continue;
 					}
 
+					if (codeWriter.IsInheritedMethod(_method) && boundMethods.count(concat(_method->DeclaringClass, "::", method.Name, '/', method.ParamCount))) {
+						MRKLog(concat("INHERITED -> ", clazz.Name, "::", method.Name, " from ", _method->DeclaringClass));
+						continue;
+					}
+
 					codeWriter.WriteMethod(_method, method.Static);
 				}
 
 				for (MRKGenDataField& field : clazz.Fields) {
+					if (!IsUsedMember(field.Name.c_str(), true))
+						continue;
+
 					MRKLog("XXMM");
 					MRKXCPPField* _field = MRKXCPPGetField(_class, field.Name.c_str());
 					if (!_field) {
@@ -452,16 +752,53 @@ namespace MRK {
 			}
 		}
 
+		for (MRKGenDataImage& genImage : ms_GenImages)
+			GenerateImage(codeWriter, genImage);
+
 		codeWriter.CloseWriter();
+
+		if (MRKUsageIsActive())
+			MRKLog(concat("Usage pruning skipped ", ms_PrunedClasses, " classes and ", ms_PrunedMembers, " members"));
+
+		MRKLog("Metadata memory (current / peak bytes, live allocations), the caches' retire lists not included:");
+
+		for (mrku32 idx = 0; idx < MRK_ALLOC_CATEGORY_COUNT; idx++) {
+			MRKAllocStats stats = MRKAllocGetStats((MRKAllocCategory)idx);
+			MRKLog(concat('\t', MRKAllocCategoryName((MRKAllocCategory)idx), ": ", stats.Current, " / ", stats.Peak, ", ", stats.Count));
+		}
+
+		//symbols are resolved lazily, only what generation touched has been looked up
+		MRKXCPPBackendSymbol* syms;
+		mrku32 symsSz = MRKXCPPBackendGetSymbols(&syms);
+		mrku32 resolved = 0;
+
+		for (mrku32 idx = 0; idx < symsSz; idx++) {
+			if (!syms[idx].Resolved)
+				continue;
+
+			if (syms[idx].Ptr)
+				resolved++;
+			else
+				MRKLog(concat("XCPP backend missing symbol: ", syms[idx].Name));
+		}
+
+		MRKLog(concat("XCPP backend resolved ", resolved, '/', symsSz, " symbols"));
 	}
 }
 
+#ifdef _WIN32
 BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpReserved) {
 	if (fdwReason == DLL_PROCESS_ATTACH)
 		MRK::Init();
 
 	return TRUE;
 }
+#else
+//preloaded into the host (LD_PRELOAD) like the dll is injected, Init runs once either way
+__attribute__((constructor)) static void MRKLoad() {
+	MRK::Init();
+}
+#endif
 
 int main() {
 	MRK::Init();
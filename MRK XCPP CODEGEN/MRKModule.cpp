@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKModule.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#include <limits.h>
+#endif
+
+namespace MRK {
+	void* MRKModuleOpen(const char* name) {
+#ifdef _WIN32
+		return GetModuleHandleA(name);
+#else
+		//prefer the copy the host already mapped, an embedded runtime may not be on the search path
+		void* module = dlopen(name, RTLD_NOW | RTLD_NOLOAD);
+		return module ? module : dlopen(name, RTLD_NOW);
+#endif
+	}
+
+	void* MRKModuleGetSymbol(void* module, const char* sym) {
+#ifdef _WIN32
+		return (void*)GetProcAddress((HMODULE)module, sym);
+#else
+		return dlsym(module, sym);
+#endif
+	}
+
+	mrks string MRKModuleGetHostPath() {
+#ifdef _WIN32
+		char path[MAX_PATH];
+		return mrks string(path, GetModuleFileNameA(0, path, MAX_PATH));
+#else
+		char path[PATH_MAX];
+		ssize_t len = readlink("/proc/self/exe", path, sizeof(path));
+		return len > 0 ? mrks string(path, len) : mrks string();
+#endif
+	}
+}
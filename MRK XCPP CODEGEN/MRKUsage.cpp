@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKUsage.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <cctype>
+
+namespace MRK {
+	mrks unordered_set<mrks string> ms_UsedClasses;
+	mrks unordered_set<mrks string> ms_UsedMembers;
+	bool ms_UsageActive = false;
+
+	bool MRKUsageIsIdentChar(char c) {
+		return isalnum((unsigned char)c) || c == '_';
+	}
+
+	void MRKUsageScanText(const mrks string& text) {
+		//every identifier may name a class, one that follows '::' may also name a member.
+		//comments and strings are scanned too, keeping too much is cheaper than a broken build
+		size_t len = text.size();
+		for (size_t i = 0; i < len;) {
+			if (!MRKUsageIsIdentChar(text[i]) || (i && MRKUsageIsIdentChar(text[i - 1]))) {
+				i++;
+				continue;
+			}
+
+			size_t start = i;
+			while (i < len && MRKUsageIsIdentChar(text[i]))
+				i++;
+
+			mrks string ident = text.substr(start, i - start);
+			if (isdigit((unsigned char)ident[0]))
+				continue;
+
+			if (start >= 2 && text[start - 1] == ':' && text[start - 2] == ':')
+				ms_UsedMembers.insert(ident);
+
+			ms_UsedClasses.insert(mrks move(ident));
+		}
+	}
+
+	bool MRKUsageScanFile(const mrksfs path& path) {
+		mrks ifstream stream(path, mrks ios_base::in | mrks ios_base::binary);
+		if (!stream)
+			return false;
+
+		mrks string text((mrks istreambuf_iterator<char>(stream)), mrks istreambuf_iterator<char>());
+		MRKUsageScanText(text);
+		return true;
+	}
+
+	mrku32 MRKUsageScan(const char* path) {
+		//pruning only starts once something was read, a missing path would otherwise prune every binding
+		mrks error_code ec;
+		if (!mrksfs is_directory(path, ec)) {
+			if (!MRKUsageScanFile(path))
+				return 0;
+
+			ms_UsageActive = true;
+			return 1;
+		}
+
+		//sources only, the generated bindings themselves would keep everything alive
+		mrku32 count = 0;
+		mrksfs recursive_directory_iterator it(path, mrksfs directory_options::skip_permission_denied, ec);
+		for (auto& entry : it) {
+			if (entry.is_directory(ec) && mrksfs exists(entry.path() / "MRKXCPPInit.h", ec)) {
+				it.disable_recursion_pending();
+				continue;
+			}
+
+			if (!entry.is_regular_file(ec))
+				continue;
+
+			mrks string ext = entry.path().extension().string();
+			if (ext != ".cpp" && ext != ".cc" && ext != ".cxx" && ext != ".c" && ext != ".h" && ext != ".hpp" && ext != ".inl")
+				continue;
+
+			if (MRKUsageScanFile(entry.path()))
+				count++;
+		}
+
+		if (count)
+			ms_UsageActive = true;
+
+		return count;
+	}
+
+	bool MRKUsageIsActive() {
+		return ms_UsageActive;
+	}
+
+	void MRKUsageAddClass(const char* name) {
+		ms_UsedClasses.insert(name);
+	}
+
+	bool MRKUsageHasClass(const char* name) {
+		return !ms_UsageActive || ms_UsedClasses.count(name);
+	}
+
+	bool MRKUsageHasMember(const char* name) {
+		return !ms_UsageActive || ms_UsedMembers.count(name);
+	}
+}
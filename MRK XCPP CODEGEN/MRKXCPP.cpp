@@ -26,70 +26,122 @@
 
 #include "MRKXCPP.h"
 #include "MRKXCPPBackend.h"
+#include "MRKAlloc.hpp"
+#include "MRKConcurrentCache.hpp"
 
+#include <cstring>
 #include <vector>
 
+#define MRK_HASH_SEED 14695981039346656037ull
+
 namespace MRK {
-    mrks vector<MRKXCPPImage*> ms_Images;
-    mrks vector<MRKXCPPClass*> ms_Classes;
-    mrks vector<MRKXCPPMethod*> ms_Methods;
-    mrks vector<MRKXCPPField*> ms_Fields;
-
-    MRKXCPPImage* MRK::MRKXCPPGetImage(const char* name) {
-        for (MRKXCPPImage* image : ms_Images) {
-            if (!strcmp(image->Name, name))
-                return image;
+    void MRKXCPPFreeType(MRKXCPPType& type) {
+        for (mrku32 i = 0; i < type.FieldCount; i++)
+            MRKAllocFree(type.Fields[i].Name);
+
+        if (type.Element) {
+            MRKXCPPFreeType(*type.Element);
+            MRKAllocFree(type.Element);
         }
 
-        MRKXCPPImage* image = MRKXCPPBackendGetImage(name);
-        if (!image)
-            return 0;
+        MRKAllocFree(type.Fields);
+        MRKAllocFree(type.Name);
+    }
 
-        ms_Images.push_back(image);
-        return image;
+    void MRKXCPPFreeMethod(MRKXCPPMethod* method) {
+        for (mrku32 i = 0; i < method->ParamCount; i++)
+            MRKXCPPFreeType(method->ParamTypes[i]);
+
+        MRKAllocFree(method->Params);
+        MRKAllocFree(method->ParamTypes);
+        MRKAllocFree(method->Name);
+        MRKAllocFree(method->GenericParams);
+        MRKAllocFree(method->BackingField);
+        MRKXCPPFreeType(method->ReturnType);
+        MRKAllocFree(method);
     }
 
-    MRKXCPPClass* MRKXCPPGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
-        for (MRKXCPPClass* clazz : ms_Classes) {
-            if (clazz->Image == image && !strcmp(namespaze, clazz->Namespace) 
-                && !strcmp(name, clazz->Name))
-                return clazz;
-        }
+    void MRKXCPPFreeField(MRKXCPPField* field) {
+        MRKAllocFree(field->Name);
+        MRKXCPPFreeType(field->Type);
+        MRKAllocFree(field);
+    }
+
+    void MRKXCPPFreeClass(MRKXCPPClass* clazz) {
+        MRKAllocFree(clazz->Namespace);
+        MRKAllocFree(clazz->Name);
+        MRKAllocFree(clazz->GenericParams);
+        MRKAllocFree(clazz->Parents);
+        MRKXCPPFreeType(clazz->Type);
+        MRKAllocFree(clazz);
+    }
 
-        MRKXCPPClass* clazz = MRKXCPPBackendGetClass(image, namespaze, name);
-        if (!clazz)
-            return 0;
+    //lookups from any thread are lock-free, only a miss takes the cache's writer lock while the backend resolves
+    MRKConcurrentCache<MRKXCPPImage> ms_Images;
+    MRKConcurrentCache<MRKXCPPClass> ms_Classes(MRKXCPPFreeClass);
+    MRKConcurrentCache<MRKXCPPMethod> ms_Methods(MRKXCPPFreeMethod);
+    MRKConcurrentCache<MRKXCPPField> ms_Fields(MRKXCPPFreeField);
 
-        ms_Classes.push_back(clazz);
-        return clazz;
+    MRKXCPPImage* MRKXCPPGetImage(const char* name) {
+        return ms_Images.FindOrAdd(MRKHashString(MRK_HASH_SEED, name), [=](MRKXCPPImage* image) {
+            return !strcmp(image->Name, name);
+        }, [=]() {
+            return MRKXCPPBackendGetImage(name);
+        });
+    }
+
+    MRKXCPPClass* MRKXCPPGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
+        mrku32ptr hash = MRKHashString(MRKHashString(MRKHashBytes(MRK_HASH_SEED, &image, sizeof(image)), namespaze), name);
+
+        return ms_Classes.FindOrAdd(hash, [=](MRKXCPPClass* clazz) {
+            return clazz->Image == image && !strcmp(namespaze, clazz->Namespace) && !strcmp(name, clazz->Name);
+        }, [=]() {
+            return MRKXCPPBackendGetClass(image, namespaze, name);
+        });
     }
 
     MRKXCPPMethod* MRKXCPPGetMethod(MRKXCPPClass* clazz, const char* methodName, int argc, int occ) {
-        for (MRKXCPPMethod* method : ms_Methods) {
-            if (method->Class == clazz && !strcmp(method->Name, methodName) 
-                && method->ParamCount == argc && method->Occurance == occ)
+        mrku32ptr hash = MRKHashString(MRKHashBytes(MRK_HASH_SEED, &clazz, sizeof(clazz)), methodName);
+        hash = MRKHashBytes(MRKHashBytes(hash, &argc, sizeof(argc)), &occ, sizeof(occ));
+
+        return ms_Methods.FindOrAdd(hash, [=](MRKXCPPMethod* method) {
+            return method->Class == clazz && !strcmp(method->Name, methodName)
+                && method->ParamCount == (mrku32)argc && method->Occurance == occ;
+        }, [=]() {
+            MRKXCPPMethod* method = MRKXCPPBackendGetMethod(clazz, methodName, argc, occ);
+            if (!method)
                 return method;
-        }
 
-        MRKXCPPMethod* method = MRKXCPPBackendGetMethod(clazz, methodName, argc, occ);
-        if (!method)
-            return 0;
+            //interned names come back null once the name table is full
+            bool named = method->DeclaringClass != 0;
+            for (mrku32 i = 0; i < method->ParamCount; i++)
+                named &= method->Params[i] != 0;
+
+            if (!named) {
+                MRKXCPPFreeMethod(method);
+                return (MRKXCPPMethod*)0;
+            }
 
-        ms_Methods.push_back(method);
-        return method;
+            return method;
+        });
     }
 
     MRKXCPPField* MRKXCPPGetField(MRKXCPPClass* clazz, const char* fieldName) {
-        for (MRKXCPPField* field : ms_Fields) {
-            if (field->Class == clazz && !strcmp(field->Name, fieldName))
-                return field;
-        }
+        mrku32ptr hash = MRKHashString(MRKHashBytes(MRK_HASH_SEED, &clazz, sizeof(clazz)), fieldName);
 
-        MRKXCPPField* field = MRKXCPPBackendGetField(clazz, fieldName);
-        if (!field)
-            return 0;
+        return ms_Fields.FindOrAdd(hash, [=](MRKXCPPField* field) {
+            return field->Class == clazz && !strcmp(field->Name, fieldName);
+        }, [=]() {
+            return MRKXCPPBackendGetField(clazz, fieldName);
+        });
+    }
 
-        ms_Fields.push_back(field);
-        return field;
+    void MRKXCPPReleaseClass(MRKXCPPClass* clazz) {
+        //drops a class and everything resolved under it, keeps the cache bounded when streaming a whole image.
+        //interned names stay. the caches free the values once no lookup can still reach them,
+        //no other thread may still hold the class itself
+        ms_Methods.RemoveIf([=](MRKXCPPMethod* method) { return method->Class == clazz; });
+        ms_Fields.RemoveIf([=](MRKXCPPField* field) { return field->Class == clazz; });
+        ms_Classes.RemoveIf([=](MRKXCPPClass* cached) { return cached == clazz; });
     }
 }
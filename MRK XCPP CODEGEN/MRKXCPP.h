@@ -34,4 +34,5 @@ namespace MRK {
 	MRKXCPPClass* MRKXCPPGetClass(MRKXCPPImage* image, const char* namespaze, const char* name);
 	MRKXCPPMethod* MRKXCPPGetMethod(MRKXCPPClass* clazz, const char* methodName, int argc, int occ = 1);
 	MRKXCPPField* MRKXCPPGetField(MRKXCPPClass* clazz, const char* fieldName);
+	void MRKXCPPReleaseClass(MRKXCPPClass* clazz);
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKXCPPBackend.h"
+#include "MRKLog.h"
+#include "Concat.hpp"
+
+#include <cstring>
+
+namespace MRK {
+	MRKXCPPBackendInterface* ms_Backend;
+
+	bool MRKXCPPBackendInit(const char* name) {
+		MRKXCPPBackendInterface* backends[] = {
+#ifdef MRK_XCPP_MONO
+			MRKXCPPBackendMono(),
+#endif
+#ifdef MRK_XCPP_IL2CPP
+			MRKXCPPBackendIl2Cpp(),
+#endif
+		};
+
+		//a process hosts one runtime, the first backend whose module opens is the one
+		for (MRKXCPPBackendInterface* backend : backends) {
+			if (name && strcmp(name, backend->Name))
+				continue;
+
+			if (backend->Init(backend->ModuleName)) {
+				ms_Backend = backend;
+				return true;
+			}
+
+			MRKLog(concat(backend->Name, " backend unavailable, ", backend->ModuleName, " is not loaded"));
+		}
+
+		return false;
+	}
+
+	const char* MRKXCPPBackendGetName() {
+		return ms_Backend ? ms_Backend->Name : 0;
+	}
+
+	mrku32 MRKXCPPBackendGetSymbols(MRKXCPPBackendSymbol** syms) {
+		return ms_Backend ? ms_Backend->GetSymbols(syms) : 0;
+	}
+
+	MRKXCPPImage* MRKXCPPBackendGetImage(const char* name) {
+		return ms_Backend->GetImage(name);
+	}
+
+	MRKXCPPClass* MRKXCPPBackendGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
+		return ms_Backend->GetClass(image, namespaze, name);
+	}
+
+	MRKXCPPMethod* MRKXCPPBackendGetMethod(MRKXCPPClass* clazz, const char* name, int argc, int occ) {
+		return ms_Backend->GetMethod(clazz, name, argc, occ);
+	}
+
+	MRKXCPPField* MRKXCPPBackendGetField(MRKXCPPClass* clazz, const char* name) {
+		return ms_Backend->GetField(clazz, name);
+	}
+
+	mrku32 MRKXCPPBackendGetClassCount(MRKXCPPImage* image) {
+		return ms_Backend->GetClassCount(image);
+	}
+
+	bool MRKXCPPBackendGetClassInfo(MRKXCPPImage* image, mrku32 idx, MRKXCPPMemberInfo* info) {
+		return ms_Backend->GetClassInfo(image, idx, info);
+	}
+
+	bool MRKXCPPBackendNextMethod(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+		return ms_Backend->NextMethod(clazz, iter, info);
+	}
+
+	bool MRKXCPPBackendNextField(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+		return ms_Backend->NextField(clazz, iter, info);
+	}
+}
@@ -29,11 +29,50 @@
 #include "MRKCommon.h"
 #include "MRKXCPPStructs.h"
 
+#include <atomic>
+
 namespace MRK {
-	bool MRKXCPPBackendInit(const char* moduleName);
-	void*** MRKXCPPBackendGetPointers(mrku32* sz);
+	//resolved lazily from whichever thread calls first, readers load Ptr with acquire
+	struct MRKXCPPBackendSymbol {
+		const char* Name;
+		mrks atomic<void*> Ptr;
+		mrks atomic<bool> Resolved; //lookup attempted, a resolved null Ptr is a missing symbol
+	};
+
+	//one per runtime, the MRKXCPPBackend* calls below forward to the one MRKXCPPBackendInit picked
+	struct MRKXCPPBackendInterface {
+		const char* Name;
+		const char* ModuleName;
+		bool (*Init)(const char* moduleName);
+		mrku32 (*GetSymbols)(MRKXCPPBackendSymbol** syms);
+		MRKXCPPImage* (*GetImage)(const char* name);
+		MRKXCPPClass* (*GetClass)(MRKXCPPImage* image, const char* namespaze, const char* name);
+		MRKXCPPMethod* (*GetMethod)(MRKXCPPClass* clazz, const char* name, int argc, int occ);
+		MRKXCPPField* (*GetField)(MRKXCPPClass* clazz, const char* name);
+		mrku32 (*GetClassCount)(MRKXCPPImage* image);
+		bool (*GetClassInfo)(MRKXCPPImage* image, mrku32 idx, MRKXCPPMemberInfo* info);
+		bool (*NextMethod)(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info);
+		bool (*NextField)(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info);
+	};
+
+#ifdef MRK_XCPP_MONO
+	MRKXCPPBackendInterface* MRKXCPPBackendMono();
+#endif
+
+#ifdef MRK_XCPP_IL2CPP
+	MRKXCPPBackendInterface* MRKXCPPBackendIl2Cpp();
+#endif
+
+	//name picks a backend ("Mono", "IL2CPP"), 0 takes the first whose runtime module is loaded
+	bool MRKXCPPBackendInit(const char* name = 0);
+	const char* MRKXCPPBackendGetName();
+	mrku32 MRKXCPPBackendGetSymbols(MRKXCPPBackendSymbol** syms);
 	MRKXCPPImage* MRKXCPPBackendGetImage(const char* name);
 	MRKXCPPClass* MRKXCPPBackendGetClass(MRKXCPPImage* image, const char* namespaze, const char* name);
 	MRKXCPPMethod* MRKXCPPBackendGetMethod(MRKXCPPClass* clazz, const char* name, int argc, int occ);
 	MRKXCPPField* MRKXCPPBackendGetField(MRKXCPPClass* clazz, const char* name);
+	mrku32 MRKXCPPBackendGetClassCount(MRKXCPPImage* image);
+	bool MRKXCPPBackendGetClassInfo(MRKXCPPImage* image, mrku32 idx, MRKXCPPMemberInfo* info);
+	bool MRKXCPPBackendNextMethod(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info);
+	bool MRKXCPPBackendNextField(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info);
 }
\ No newline at end of file
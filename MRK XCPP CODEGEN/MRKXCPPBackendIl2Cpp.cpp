@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKCommon.h"
+
+#ifdef MRK_XCPP_IL2CPP
+
+#include "MRKXCPPBackend.h"
+#include "MRKAlloc.hpp"
+#include "MRKLog.h"
+#include "Concat.hpp"
+#include "MRKModule.h"
+#include "MRKXCPPNames.h"
+#include "MRKXCPPBackendIl2Cpp.h"
+
+#include <cstring>
+
+namespace MRK {
+#define X(ret, name, params) typedef ret (*MRKIl2Cpp_##name) params;
+    MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+
+    enum MRKIl2CppFunction {
+#define X(ret, name, params) MRK_IL2CPP_##name,
+        MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+        MRK_IL2CPP_FUNCTION_COUNT
+    };
+
+    //what a missing entry point resolves to, a call returns 0 instead of jumping to null
+#define X(ret, name, params) ret MRKIl2CppMissing_##name params { return (ret)0; }
+    MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+
+    void* ms_Il2CppFallbacks[MRK_IL2CPP_FUNCTION_COUNT] = {
+#define X(ret, name, params) (void*)&MRKIl2CppMissing_##name,
+        MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+    };
+
+    //resolved on first use
+    MRKXCPPBackendSymbol ms_Il2CppSymbols[MRK_IL2CPP_FUNCTION_COUNT] = {
+#define X(ret, name, params) { #name, 0, false },
+        MRK_IL2CPP_FUNCTIONS(X)
+#undef X
+    };
+
+    void* ms_Il2CppModule;
+    void* ms_Il2CppDomain;
+
+    void* MRKIl2CppResolve(mrku32 idx) {
+        //racing threads look up and publish the same address, only the first lookup reports a miss
+        MRKXCPPBackendSymbol& sym = ms_Il2CppSymbols[idx];
+        void* ptr = MRKModuleGetSymbol(ms_Il2CppModule, sym.Name);
+        if (ptr)
+            sym.Ptr.store(ptr, mrks memory_order_release);
+
+        if (!sym.Resolved.exchange(true, mrks memory_order_acq_rel) && !ptr)
+            MRKLog(concat("Missing il2cpp symbol ", sym.Name));
+
+        //the table keeps the miss so it shows up in the symbol report
+        return ptr ? ptr : ms_Il2CppFallbacks[idx];
+    }
+
+    inline void* MRKIl2CppGet(mrku32 idx) {
+        void* ptr = ms_Il2CppSymbols[idx].Ptr.load(mrks memory_order_acquire);
+        return ptr ? ptr : MRKIl2CppResolve(idx);
+    }
+
+#define IL2CPP(name) ((MRKIl2Cpp_##name)MRKIl2CppGet(MRK_IL2CPP_##name))
+
+    bool MRKIl2CppInit(const char* moduleName) {
+        ms_Il2CppModule = MRKModuleOpen(moduleName);
+        return ms_Il2CppModule != 0;
+    }
+
+    mrku32 MRKIl2CppGetSymbols(MRKXCPPBackendSymbol** syms) {
+        if (syms)
+            *syms = ms_Il2CppSymbols;
+
+        return MRK_IL2CPP_FUNCTION_COUNT;
+    }
+
+    void MRKIl2CppThreadAttach() {
+        if (!ms_Il2CppDomain)
+            ms_Il2CppDomain = IL2CPP(il2cpp_domain_get)();
+
+        IL2CPP(il2cpp_thread_attach)(ms_Il2CppDomain);
+    }
+
+    void MRKIl2CppCopyTypeName(void* type, char** dest, MRKAllocCategory category) {
+        //il2cpp hands out its own allocation
+        char* name = IL2CPP(il2cpp_type_get_name)(type);
+        MRKCopyString(dest, name ? name : "", category);
+
+        if (name)
+            IL2CPP(il2cpp_free)(name);
+    }
+
+    mrku32 MRKIl2CppGetTypeKind(void* type) {
+        mrku32 kind = (mrku32)IL2CPP(il2cpp_type_get_type)(type);
+
+        if (kind == MRK_TYPE_VALUETYPE) {
+            void* clazz = IL2CPP(il2cpp_class_from_type)(type);
+            if (IL2CPP(il2cpp_class_is_enum)(clazz))
+                return MRKIl2CppGetTypeKind(IL2CPP(il2cpp_class_enum_basetype)(clazz));
+        }
+        else if (kind == MRK_TYPE_GENERICINST)
+            return IL2CPP(il2cpp_class_is_valuetype)(IL2CPP(il2cpp_class_from_type)(type)) ? MRK_TYPE_VALUETYPE : MRK_TYPE_CLASS;
+
+        return kind;
+    }
+
+    void MRKIl2CppResolveType(void* type, MRKXCPPType* mtype) {
+        MRKIl2CppCopyTypeName(type, &mtype->Name, MRK_ALLOC_TYPE);
+        mtype->Kind = MRKIl2CppGetTypeKind(type);
+        mtype->Size = 0;
+        mtype->FieldCount = 0;
+        mtype->Fields = 0;
+        mtype->Element = 0;
+
+        if (mtype->Kind == MRK_TYPE_SZARRAY) {
+            void* element = IL2CPP(il2cpp_class_get_element_class)(IL2CPP(il2cpp_class_from_type)(type));
+
+            mtype->Element = MRKAllocNew<MRKXCPPType>(MRK_ALLOC_TYPE);
+            MRKIl2CppResolveType(IL2CPP(il2cpp_class_get_type)(element), mtype->Element);
+            return;
+        }
+
+        if (mtype->Kind != MRK_TYPE_VALUETYPE)
+            return;
+
+        void* clazz = IL2CPP(il2cpp_class_from_type)(type);
+
+        mrku32 align;
+        mtype->Size = (mrku32)IL2CPP(il2cpp_class_value_size)(clazz, &align);
+
+        void* iter = 0;
+        void* field;
+        while ((field = IL2CPP(il2cpp_class_get_fields)(clazz, &iter))) {
+            if (!(IL2CPP(il2cpp_field_get_flags)(field) & IL2CPP_FIELD_ATTRIBUTE_STATIC))
+                mtype->FieldCount++;
+        }
+
+        if (!mtype->FieldCount)
+            return;
+
+        mtype->Fields = MRKAllocNewArr<MRKXCPPValueField>(mtype->FieldCount, MRK_ALLOC_TYPE);
+
+        iter = 0;
+        mrku32 idx = 0;
+        while ((field = IL2CPP(il2cpp_class_get_fields)(clazz, &iter))) {
+            if (IL2CPP(il2cpp_field_get_flags)(field) & IL2CPP_FIELD_ATTRIBUTE_STATIC)
+                continue;
+
+            //field offsets of value types still count the object header
+            MRKXCPPValueField& vfield = mtype->Fields[idx++];
+            MRKCopyString(&vfield.Name, IL2CPP(il2cpp_field_get_name)(field), MRK_ALLOC_TYPE);
+            vfield.Kind = MRKIl2CppGetTypeKind(IL2CPP(il2cpp_field_get_type)(field));
+            vfield.Offset = (mrku32)IL2CPP(il2cpp_field_get_offset)(field) - IL2CPP_OBJECT_HEADER_SIZE;
+        }
+    }
+
+    mrku32 MRKIl2CppGetGenericParams(void* method, mrks string* params) {
+        //il2cpp exports no accessor for generic parameters, their names come from the signature (T, TKey...)
+        //and from the arguments of the generic instances, arrays and pointers in it (Dictionary`2<TKey,TValue>, T[]).
+        //(mrku32)-1 when none shows up, the method is skipped rather than bound with a guessed arity
+        if (!IL2CPP(il2cpp_method_is_generic)(method))
+            return 0;
+
+        void* declaring = IL2CPP(il2cpp_method_get_class)(method);
+        void* image = IL2CPP(il2cpp_class_get_image)(declaring);
+
+        //the declaring class' own parameters (List`1<T>) print the same way
+        mrks string classParams = ",";
+        char* className = IL2CPP(il2cpp_type_get_name)(IL2CPP(il2cpp_class_get_type)(declaring));
+        if (className) {
+            const char* open = strchr(className, '<');
+            if (strchr(className, '`') && open) {
+                for (const char* c = open + 1; *c && *c != '>'; c++) {
+                    if (*c != ' ')
+                        classParams += *c;
+                }
+
+                classParams += ',';
+            }
+
+            IL2CPP(il2cpp_free)(className);
+        }
+
+        mrks string list = ",";
+        mrku32 arity = 0;
+        mrku32 count = IL2CPP(il2cpp_method_get_param_count)(method);
+
+        for (mrku32 i = 0; i <= count; i++) {
+            void* type = i < count ? IL2CPP(il2cpp_method_get_param)(method, i) : IL2CPP(il2cpp_method_get_return_type)(method);
+            if (!type)
+                continue;
+
+            int kind = IL2CPP(il2cpp_type_get_type)(type);
+            bool nested = kind == MRK_TYPE_GENERICINST || kind == MRK_TYPE_SZARRAY || kind == MRK_TYPE_ARRAY ||
+                kind == MRK_TYPE_BYREF || kind == MRK_TYPE_PTR;
+
+            if (kind != MRK_TYPE_MVAR && !nested)
+                continue;
+
+            char* name = IL2CPP(il2cpp_type_get_name)(type);
+            if (!name)
+                continue;
+
+            //a bare name is a parameter, nested ones are told apart from real types by carrying no namespace,
+            //not being the class' and not naming a class of the global namespace
+            const char* c = name;
+            while (*c) {
+                const char* start = c;
+                while (*c && !strchr("<>,[]&* ", *c))
+                    c++;
+
+                mrks string token(start, c - start);
+                if (*c)
+                    c++;
+
+                if (token.empty() || list.find(concat(',', token, ',')) != mrks string::npos)
+                    continue;
+
+                if (nested && (token.find_first_of(".`/") != mrks string::npos ||
+                    classParams.find(concat(',', token, ',')) != mrks string::npos ||
+                    IL2CPP(il2cpp_class_from_name)(image, "", token.c_str())))
+                    continue;
+
+                concat_into(list, token, ',');
+                arity++;
+            }
+
+            IL2CPP(il2cpp_free)(name);
+        }
+
+        if (!arity)
+            return (mrku32)-1;
+
+        if (params)
+            *params = list.substr(1, list.size() - 2);
+
+        return arity;
+    }
+
+    MRKXCPPImage* MRKIl2CppGetImage(const char* name) {
+        MRKIl2CppThreadAttach();
+
+        //il2cpp keeps the file name, UnityEngine.CoreModule.dll
+        mrks string fileName = concat(name, ".dll");
+
+        size_t count = 0;
+        void** assemblies = IL2CPP(il2cpp_domain_get_assemblies)(ms_Il2CppDomain, &count);
+
+        void* found = 0;
+        for (size_t i = 0; i < count && !found; i++) {
+            void* img = IL2CPP(il2cpp_assembly_get_image)(assemblies[i]);
+            const char* imgName = IL2CPP(il2cpp_image_get_name)(img);
+
+            if (imgName && (!strcmp(imgName, name) || fileName == imgName))
+                found = img;
+        }
+
+        if (!found)
+            return 0;
+
+        MRKXCPPImage* image = MRKAllocNew<MRKXCPPImage>(MRK_ALLOC_IMAGE);
+        image->Ptr = found;
+
+        MRKCopyString(&image->Name, name, MRK_ALLOC_IMAGE);
+
+        //no module version id survives conversion, generated bindings resolve by name
+        image->Mvid = 0;
+
+        return image;
+    }
+
+    MRKXCPPClass* MRKIl2CppGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
+        MRKIl2CppThreadAttach();
+
+        if (!image)
+            return 0;
+
+        void* clazz = IL2CPP(il2cpp_class_from_name)(image->Ptr, namespaze, name);
+        if (!clazz)
+            return 0;
+
+        MRKXCPPClass* mclass = MRKAllocNew<MRKXCPPClass>(MRK_ALLOC_CLASS);
+        mclass->Ptr = clazz;
+        mclass->Image = image;
+
+        MRKCopyString(&mclass->Namespace, namespaze, MRK_ALLOC_CLASS);
+        MRKCopyString(&mclass->Name, name, MRK_ALLOC_CLASS);
+
+        MRKIl2CppResolveType(IL2CPP(il2cpp_class_get_type)(clazz), &mclass->Type);
+        mclass->Token = IL2CPP(il2cpp_class_get_type_token)(clazz);
+
+        //every delegate type derives straight from MulticastDelegate
+        void* parent = IL2CPP(il2cpp_class_get_parent)(clazz);
+        mclass->Delegate = parent && !strcmp(IL2CPP(il2cpp_class_get_namespace)(parent), "System")
+            && !strcmp(IL2CPP(il2cpp_class_get_name)(parent), "MulticastDelegate");
+
+        mrks string parents;
+        for (; parent; parent = IL2CPP(il2cpp_class_get_parent)(parent))
+            concat_into(parents, parents.empty() ? "" : ",", IL2CPP(il2cpp_class_get_namespace)(parent), '.', IL2CPP(il2cpp_class_get_name)(parent));
+
+        mclass->Parents = 0;
+        if (!parents.empty())
+            MRKCopyString(&mclass->Parents, parents.c_str(), MRK_ALLOC_CLASS);
+
+        //generic definitions are named List`1<T>
+        mclass->GenericParams = 0;
+
+        const char* open = strchr(mclass->Type.Name, '<');
+        if (strchr(name, '`') && open) {
+            mrks string params;
+            for (const char* c = open + 1; *c && *c != '>'; c++) {
+                if (*c != ' ')
+                    params += *c;
+            }
+
+            MRKCopyString(&mclass->GenericParams, params.c_str(), MRK_ALLOC_CLASS);
+        }
+
+        return mclass;
+    }
+
+    MRKXCPPMethod* MRKIl2CppGetMethod(MRKXCPPClass* clazz, const char* name, int argc, int occ) {
+        MRKIl2CppThreadAttach();
+
+        if (!clazz)
+            return 0;
+
+        void* method = 0;
+        if (occ == 1)
+            method = IL2CPP(il2cpp_class_get_method_from_name)(clazz->Ptr, name, argc);
+        else {
+            void* iter = 0;
+            int _occ = 0;
+            while ((method = IL2CPP(il2cpp_class_get_methods)(clazz->Ptr, &iter))) {
+                if (!strcmp(IL2CPP(il2cpp_method_get_name)(method), name) &&
+                    IL2CPP(il2cpp_method_get_param_count)(method) == (mrku32)argc) {
+                    _occ++;
+
+                    if (_occ == occ)
+                        break;
+                }
+            }
+        }
+
+        if (!method)
+            return 0;
+
+        mrks string genericParams;
+        mrku32 arity = MRKIl2CppGetGenericParams(method, &genericParams);
+        if (arity == (mrku32)-1)
+            return 0;
+
+        MRKXCPPMethod* mmethod = MRKAllocNew<MRKXCPPMethod>(MRK_ALLOC_METHOD);
+        mmethod->Ptr = method;
+        mmethod->Class = clazz;
+        mmethod->Occurance = occ;
+
+        MRKCopyString(&mmethod->Name, name, MRK_ALLOC_METHOD);
+
+        //lookups by name also find methods a base class declares, their token is only valid in the declaring image
+        void* declaring = IL2CPP(il2cpp_method_get_class)(method);
+        mmethod->Token = IL2CPP(il2cpp_class_get_image)(declaring) == IL2CPP(il2cpp_class_get_image)(clazz->Ptr) ?
+            IL2CPP(il2cpp_method_get_token)(method) : 0;
+
+        mrku32 iflags;
+        mrku32 flags = IL2CPP(il2cpp_method_get_flags)(method, &iflags);
+        mmethod->ICall = iflags & IL2CPP_METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL;
+        mmethod->Virtual = (flags & IL2CPP_METHOD_ATTRIBUTE_VIRTUAL) && !(flags & (IL2CPP_METHOD_ATTRIBUTE_FINAL | IL2CPP_METHOD_ATTRIBUTE_STATIC));
+
+        mmethod->DeclaringClass = MRKXCPPGetName(MRKXCPPInternName(
+            concat(IL2CPP(il2cpp_class_get_namespace)(declaring), '.', IL2CPP(il2cpp_class_get_name)(declaring)).c_str()));
+
+        mmethod->ParamCount = IL2CPP(il2cpp_method_get_param_count)(method);
+        mmethod->Params = MRKAllocNewArr<char*>(mmethod->ParamCount, MRK_ALLOC_PARAMS);
+        mmethod->ParamTypes = MRKAllocNewArr<MRKXCPPType>(mmethod->ParamCount, MRK_ALLOC_PARAMS);
+
+        for (mrku32 idx = 0; idx < mmethod->ParamCount; idx++) {
+            void* type = IL2CPP(il2cpp_method_get_param)(method, idx);
+            MRKIl2CppResolveType(type, &mmethod->ParamTypes[idx]);
+            mmethod->Params[idx] = (char*)MRKXCPPGetName(MRKXCPPInternName(mmethod->ParamTypes[idx].Name));
+        }
+
+        MRKIl2CppResolveType(IL2CPP(il2cpp_method_get_return_type)(method), &mmethod->ReturnType);
+
+        mmethod->GenericParams = 0;
+
+        if (arity)
+            MRKCopyString(&mmethod->GenericParams, genericParams.c_str(), MRK_ALLOC_METHOD);
+
+        //there is no IL left to recognize trivial accessors in
+        mmethod->BackingField = 0;
+
+        return mmethod;
+    }
+
+    MRKXCPPField* MRKIl2CppGetField(MRKXCPPClass* clazz, const char* name) {
+        MRKIl2CppThreadAttach();
+
+        if (!clazz)
+            return 0;
+
+        void* field = IL2CPP(il2cpp_class_get_field_from_name)(clazz->Ptr, name);
+        if (!field)
+            return 0;
+
+        MRKXCPPField* mfield = MRKAllocNew<MRKXCPPField>(MRK_ALLOC_FIELD);
+        mfield->Ptr = field;
+        mfield->Class = clazz;
+
+        MRKCopyString(&mfield->Name, name, MRK_ALLOC_FIELD);
+        mfield->Token = 0; //not exported, fields bind by name
+
+        mrku32 flags = IL2CPP(il2cpp_field_get_flags)(field);
+        mfield->Static = (flags & IL2CPP_FIELD_ATTRIBUTE_STATIC) && !(flags & IL2CPP_FIELD_ATTRIBUTE_LITERAL);
+
+        //thread statics (THREAD_STATIC_FIELD_OFFSET) live outside the static data and stay on the field value path
+        if (mfield->Static && IL2CPP(il2cpp_field_get_offset)(field) == (size_t)-1)
+            mfield->Static = false;
+
+        MRKIl2CppResolveType(IL2CPP(il2cpp_field_get_type)(field), &mfield->Type);
+
+        return mfield;
+    }
+
+    mrku32 MRKIl2CppGetClassCount(MRKXCPPImage* image) {
+        MRKIl2CppThreadAttach();
+
+        if (!image)
+            return 0;
+
+        return (mrku32)IL2CPP(il2cpp_image_get_class_count)(image->Ptr);
+    }
+
+    bool MRKIl2CppGetClassInfo(MRKXCPPImage* image, mrku32 idx, MRKXCPPMemberInfo* info) {
+        if (!image || !info)
+            return false;
+
+        void* clazz = IL2CPP(il2cpp_image_get_class)(image->Ptr, idx);
+        if (!clazz)
+            return false;
+
+        mrku32 flags = IL2CPP(il2cpp_class_get_flags)(clazz);
+
+        info->Namespace = IL2CPP(il2cpp_class_get_namespace)(clazz);
+        info->Name = IL2CPP(il2cpp_class_get_name)(clazz);
+        info->ParamCount = 0;
+        info->GenericArity = 0;
+        info->Static = false;
+        info->Public = (flags & IL2CPP_TYPE_ATTRIBUTE_VISIBILITY_MASK) == IL2CPP_TYPE_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    bool MRKIl2CppNextMethod(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+        if (!clazz || !info)
+            return false;
+
+        void* method = IL2CPP(il2cpp_class_get_methods)(clazz->Ptr, iter);
+        if (!method)
+            return false;
+
+        mrku32 iflags;
+        mrku32 flags = IL2CPP(il2cpp_method_get_flags)(method, &iflags);
+
+        info->Namespace = clazz->Namespace;
+        info->Name = IL2CPP(il2cpp_method_get_name)(method);
+        info->ParamCount = IL2CPP(il2cpp_method_get_param_count)(method);
+        //an undetermined arity stays non zero, GetMethod refuses the method
+        info->GenericArity = MRKIl2CppGetGenericParams(method, 0);
+        info->Static = flags & IL2CPP_METHOD_ATTRIBUTE_STATIC;
+        info->Public = (flags & IL2CPP_METHOD_ATTRIBUTE_MEMBER_ACCESS_MASK) == IL2CPP_METHOD_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    bool MRKIl2CppNextField(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+        if (!clazz || !info)
+            return false;
+
+        void* field;
+        mrku32 flags;
+        do {
+            field = IL2CPP(il2cpp_class_get_fields)(clazz->Ptr, iter);
+            if (!field)
+                return false;
+
+            flags = IL2CPP(il2cpp_field_get_flags)(field);
+        } while (flags & IL2CPP_FIELD_ATTRIBUTE_LITERAL); //constants have no storage to bind to
+
+        info->Namespace = clazz->Namespace;
+        info->Name = IL2CPP(il2cpp_field_get_name)(field);
+        info->ParamCount = 0;
+        info->GenericArity = 0;
+        info->Static = flags & IL2CPP_FIELD_ATTRIBUTE_STATIC;
+        info->Public = (flags & IL2CPP_FIELD_ATTRIBUTE_FIELD_ACCESS_MASK) == IL2CPP_FIELD_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    MRKXCPPBackendInterface ms_Il2CppBackend = {
+        "IL2CPP",
+        IL2CPP_MODULE_NAME,
+        MRKIl2CppInit,
+        MRKIl2CppGetSymbols,
+        MRKIl2CppGetImage,
+        MRKIl2CppGetClass,
+        MRKIl2CppGetMethod,
+        MRKIl2CppGetField,
+        MRKIl2CppGetClassCount,
+        MRKIl2CppGetClassInfo,
+        MRKIl2CppNextMethod,
+        MRKIl2CppNextField
+    };
+
+    MRKXCPPBackendInterface* MRKXCPPBackendIl2Cpp() {
+        return &ms_Il2CppBackend;
+    }
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#pragma once
+
+#include "MRKCommon.h"
+
+//same ECMA-335 attribute bits as the mono backend
+#define IL2CPP_TYPE_ATTRIBUTE_VISIBILITY_MASK 0x00000007
+#define IL2CPP_TYPE_ATTRIBUTE_PUBLIC 0x00000001
+
+#define IL2CPP_METHOD_ATTRIBUTE_MEMBER_ACCESS_MASK 0x0007
+#define IL2CPP_METHOD_ATTRIBUTE_PUBLIC 0x0006
+#define IL2CPP_METHOD_ATTRIBUTE_STATIC 0x0010
+#define IL2CPP_METHOD_ATTRIBUTE_FINAL 0x0020
+#define IL2CPP_METHOD_ATTRIBUTE_VIRTUAL 0x0040
+
+#define IL2CPP_METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL 0x1000
+
+#define IL2CPP_FIELD_ATTRIBUTE_FIELD_ACCESS_MASK 0x0007
+#define IL2CPP_FIELD_ATTRIBUTE_PUBLIC 0x0006
+#define IL2CPP_FIELD_ATTRIBUTE_STATIC 0x0010
+#define IL2CPP_FIELD_ATTRIBUTE_LITERAL 0x0040
+
+#define IL2CPP_OBJECT_HEADER_SIZE (2 * sizeof(void*))
+
+//every il2cpp export the backend uses with its exact prototype, see MRK_MONO_FUNCTIONS.
+//the test stand-in implements the same list
+#define MRK_IL2CPP_FUNCTIONS(X) \
+    X(void*, il2cpp_domain_get, ()) \
+    X(void*, il2cpp_thread_attach, (void* domain)) \
+    X(void**, il2cpp_domain_get_assemblies, (void* domain, size_t* size)) \
+    X(void*, il2cpp_assembly_get_image, (void* assembly)) \
+    X(const char*, il2cpp_image_get_name, (void* image)) \
+    X(size_t, il2cpp_image_get_class_count, (void* image)) \
+    X(void*, il2cpp_image_get_class, (void* image, size_t index)) \
+    X(void*, il2cpp_class_from_name, (void* image, const char* namespaze, const char* name)) \
+    X(void*, il2cpp_class_from_type, (void* type)) \
+    X(void*, il2cpp_class_get_type, (void* clazz)) \
+    X(mrku32, il2cpp_class_get_type_token, (void* clazz)) \
+    X(void*, il2cpp_class_get_parent, (void* clazz)) \
+    X(void*, il2cpp_class_get_image, (void* clazz)) \
+    X(const char*, il2cpp_class_get_name, (void* clazz)) \
+    X(const char*, il2cpp_class_get_namespace, (void* clazz)) \
+    X(int, il2cpp_class_get_flags, (void* clazz)) \
+    X(bool, il2cpp_class_is_enum, (void* clazz)) \
+    X(bool, il2cpp_class_is_valuetype, (void* clazz)) \
+    X(void*, il2cpp_class_enum_basetype, (void* clazz)) \
+    X(int, il2cpp_class_value_size, (void* clazz, mrku32* align)) \
+    X(void*, il2cpp_class_get_element_class, (void* clazz)) \
+    X(void*, il2cpp_class_get_fields, (void* clazz, void** iter)) \
+    X(void*, il2cpp_class_get_field_from_name, (void* clazz, const char* name)) \
+    X(void*, il2cpp_class_get_methods, (void* clazz, void** iter)) \
+    X(void*, il2cpp_class_get_method_from_name, (void* clazz, const char* name, int argc)) \
+    X(const char*, il2cpp_field_get_name, (void* field)) \
+    X(int, il2cpp_field_get_flags, (void* field)) \
+    X(void*, il2cpp_field_get_type, (void* field)) \
+    X(size_t, il2cpp_field_get_offset, (void* field)) \
+    X(const char*, il2cpp_method_get_name, (void* method)) \
+    X(mrku32, il2cpp_method_get_param_count, (void* method)) \
+    X(void*, il2cpp_method_get_param, (void* method, mrku32 index)) \
+    X(void*, il2cpp_method_get_return_type, (void* method)) \
+    X(mrku32, il2cpp_method_get_flags, (void* method, mrku32* iflags)) \
+    X(mrku32, il2cpp_method_get_token, (void* method)) \
+    X(bool, il2cpp_method_is_generic, (void* method)) \
+    X(void*, il2cpp_method_get_class, (void* method)) \
+    X(char*, il2cpp_type_get_name, (void* type)) \
+    X(int, il2cpp_type_get_type, (void* type)) \
+    X(void, il2cpp_free, (void* ptr))
@@ -32,116 +32,162 @@
 #include "MRKAlloc.hpp"
 #include "MRKLog.h"
 #include "Concat.hpp"
-
-#include <Windows.h>
+#include "MRKModule.h"
+#include "MRKXCPPNames.h"
+
+#include <cstring>
+
+#define MONO_TABLE_TYPEDEF 2
+#define MONO_TOKEN_TYPE_DEF 0x02000000
+
+#define TYPE_ATTRIBUTE_VISIBILITY_MASK 0x00000007
+#define TYPE_ATTRIBUTE_PUBLIC 0x00000001
+
+#define METHOD_ATTRIBUTE_MEMBER_ACCESS_MASK 0x0007
+#define METHOD_ATTRIBUTE_PUBLIC 0x0006
+#define METHOD_ATTRIBUTE_STATIC 0x0010
+#define METHOD_ATTRIBUTE_FINAL 0x0020
+#define METHOD_ATTRIBUTE_VIRTUAL 0x0040
+
+#define METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL 0x1000
+
+#define FIELD_ATTRIBUTE_FIELD_ACCESS_MASK 0x0007
+#define FIELD_ATTRIBUTE_PUBLIC 0x0006
+#define FIELD_ATTRIBUTE_STATIC 0x0010
+#define FIELD_ATTRIBUTE_LITERAL 0x0040
+
+#define MONO_OBJECT_HEADER_SIZE (2 * sizeof(void*))
+
+//every mono entry point the backend uses with its exact prototype, the symbol table, its size and the typed pointers are derived from this list
+#define MRK_MONO_FUNCTIONS(X) \
+    X(void*, mono_class_from_name, (void* image, const char* namespaze, const char* name)) \
+    X(void*, mono_get_root_domain, ()) \
+    X(void*, mono_thread_attach, (void* domain)) \
+    X(void*, mono_image_open_from_data, (char* data, mrku32 len, int needCopy, int* status)) \
+    X(void*, mono_assembly_name_new, (const char* name)) \
+    X(void*, mono_assembly_loaded, (void* aname)) \
+    X(void*, mono_assembly_get_image, (void* assembly)) \
+    X(void*, mono_class_get_method_from_name, (void* clazz, const char* name, int argc)) \
+    X(void*, mono_runtime_invoke, (void* method, void* obj, void** params, void** exc)) \
+    X(void*, mono_domain_assembly_open, (void* domain, const char* name)) \
+    X(void, mono_assembly_foreach, (void (*func)(void* assembly, void* userData), void* userData)) \
+    X(const char*, mono_image_get_name, (void* image)) \
+    X(void*, mono_method_signature, (void* method)) \
+    X(mrku32, mono_signature_get_param_count, (void* sig)) \
+    X(void*, mono_signature_get_params, (void* sig, void** iter)) \
+    X(void*, mono_type_get_class, (void* type)) \
+    X(const char*, mono_class_get_name, (void* clazz)) \
+    X(const char*, mono_class_get_namespace, (void* clazz)) \
+    X(void*, mono_class_get_image, (void* clazz)) \
+    X(char*, mono_type_get_name, (void* type)) \
+    X(void*, mono_class_get_field_from_name, (void* clazz, const char* name)) \
+    X(void*, mono_class_get_methods, (void* clazz, void** iter)) \
+    X(const char*, mono_method_get_name, (void* method)) \
+    X(int, mono_image_get_table_rows, (void* image, int table)) \
+    X(void*, mono_class_get, (void* image, mrku32 token)) \
+    X(mrku32, mono_class_get_flags, (void* clazz)) \
+    X(void*, mono_class_get_fields, (void* clazz, void** iter)) \
+    X(const char*, mono_field_get_name, (void* field)) \
+    X(mrku32, mono_field_get_flags, (void* field)) \
+    X(mrku32, mono_method_get_flags, (void* method, mrku32* iflags)) \
+    X(void*, mono_signature_get_return_type, (void* sig)) \
+    X(int, mono_type_get_type, (void* type)) \
+    X(void*, mono_class_from_mono_type, (void* type)) \
+    X(int, mono_class_is_enum, (void* clazz)) \
+    X(void*, mono_class_enum_basetype, (void* clazz)) \
+    X(int, mono_class_is_valuetype, (void* clazz)) \
+    X(int, mono_class_value_size, (void* clazz, mrku32* align)) \
+    X(void*, mono_field_get_type, (void* field)) \
+    X(mrku32, mono_field_get_offset, (void* field)) \
+    X(void*, mono_class_get_element_class, (void* clazz)) \
+    X(void*, mono_class_get_type, (void* clazz)) \
+    X(const char*, mono_image_get_guid, (void* image)) \
+    X(mrku32, mono_class_get_type_token, (void* clazz)) \
+    X(mrku32, mono_method_get_token, (void* method)) \
+    X(mrku32, mono_class_get_field_token, (void* field)) \
+    X(char*, mono_method_full_name, (void* method, int signature)) \
+    X(void, mono_free, (void* ptr)) \
+    X(void*, mono_class_get_parent, (void* clazz)) \
+    X(void*, mono_method_get_class, (void* method)) \
+    X(void*, mono_method_get_header, (void* method)) \
+    X(const unsigned char*, mono_method_header_get_code, (void* header, mrku32* codeSize, mrku32* maxStack)) \
+    X(void, mono_metadata_free_mh, (void* header)) \
+    X(void*, mono_class_get_field, (void* clazz, mrku32 token)) \
+    X(void*, mono_field_get_parent, (void* field))
 
 namespace MRK {
-	typedef void* (*DynFunction)(...);
-
-    DynFunction mono_class_from_name;
-    DynFunction mono_get_root_domain;
-    DynFunction mono_thread_attach;
-    DynFunction mono_image_open_from_data;
-    DynFunction mono_assembly_name_new;
-    DynFunction mono_assembly_loaded;
-    DynFunction mono_assembly_get_image;
-    DynFunction mono_class_get_method_from_name;
-    DynFunction mono_runtime_invoke;
-    DynFunction mono_domain_assembly_open;
-    DynFunction mono_assembly_foreach;
-    DynFunction mono_image_get_name;
-    DynFunction mono_method_signature;
-    DynFunction mono_signature_get_param_count;
-    DynFunction mono_signature_get_params;
-    DynFunction mono_type_get_class;
-    DynFunction mono_class_get_name;
-    DynFunction mono_class_get_namespace;
-    DynFunction mono_class_get_image;
-    DynFunction mono_type_get_name;
-    DynFunction mono_class_get_field_from_name;
-    DynFunction mono_class_get_methods;
-    DynFunction mono_method_get_name;
+#define X(ret, name, params) typedef ret (*MRKMono_##name) params;
+    MRK_MONO_FUNCTIONS(X)
+#undef X
+
+    enum MRKMonoFunction {
+#define X(ret, name, params) MRK_MONO_##name,
+        MRK_MONO_FUNCTIONS(X)
+#undef X
+        MRK_MONO_FUNCTION_COUNT
+    };
+
+    //what a missing entry point resolves to, a call returns 0 instead of jumping to null
+#define X(ret, name, params) ret MRKMonoMissing_##name params { return (ret)0; }
+    MRK_MONO_FUNCTIONS(X)
+#undef X
+
+    void* ms_MonoFallbacks[MRK_MONO_FUNCTION_COUNT] = {
+#define X(ret, name, params) (void*)&MRKMonoMissing_##name,
+        MRK_MONO_FUNCTIONS(X)
+#undef X
+    };
+
+    //resolved on first use
+    MRKXCPPBackendSymbol ms_Symbols[MRK_MONO_FUNCTION_COUNT] = {
+#define X(ret, name, params) { #name, 0, false },
+        MRK_MONO_FUNCTIONS(X)
+#undef X
+    };
 
+    void* ms_Module;
     void* ms_RootDomain;
     const char* ms_CachedImageName;
     void* ms_CachedImage;
 
-	void*** ms_IndexPointerMapping = new void** [MONO_FUNCTION_COUNT] {
-            (void**)&mono_class_from_name,
-            (void**)&mono_get_root_domain,
-            (void**)&mono_thread_attach,
-            (void**)&mono_image_open_from_data,
-            (void**)&mono_assembly_name_new,
-            (void**)&mono_assembly_loaded,
-            (void**)&mono_assembly_get_image,
-            (void**)&mono_class_get_method_from_name,
-            (void**)&mono_runtime_invoke,
-            (void**)&mono_domain_assembly_open,
-            (void**)&mono_assembly_foreach,
-            (void**)&mono_image_get_name,
-            (void**)&mono_method_signature,
-            (void**)&mono_signature_get_param_count,
-            (void**)&mono_signature_get_params,
-            (void**)&mono_type_get_class,
-            (void**)&mono_class_get_name,
-            (void**)&mono_class_get_namespace,
-            (void**)&mono_class_get_image,
-            (void**)&mono_type_get_name,
-            (void**)&mono_class_get_field_from_name,
-            (void**)&mono_class_get_methods,
-            (void**)&mono_method_get_name
-	};
-
-    const char** ms_FunctionSyms = new const char* [MONO_FUNCTION_COUNT] {
-            "mono_class_from_name",
-            "mono_get_root_domain",
-            "mono_thread_attach",
-            "mono_image_open_from_data",
-            "mono_assembly_name_new",
-            "mono_assembly_loaded",
-            "mono_assembly_get_image",
-            "mono_class_get_method_from_name",
-            "mono_runtime_invoke",
-            "mono_domain_assembly_open",
-            "mono_assembly_foreach",
-            "mono_image_get_name",
-            "mono_method_signature",
-            "mono_signature_get_param_count",
-            "mono_signature_get_params",
-            "mono_type_get_class",
-            "mono_class_get_name",
-            "mono_class_get_namespace",
-            "mono_class_get_image",
-            "mono_type_get_name",
-            "mono_class_get_field_from_name",
-            "mono_class_get_methods",
-            "mono_method_get_name"
-    };
+    void* MRKMonoResolve(mrku32 idx) {
+        //racing threads look up and publish the same address, only the first lookup reports a miss
+        MRKXCPPBackendSymbol& sym = ms_Symbols[idx];
+        void* ptr = MRKModuleGetSymbol(ms_Module, sym.Name);
+        if (ptr)
+            sym.Ptr.store(ptr, mrks memory_order_release);
 
-	bool MRKXCPPBackendInit(const char* moduleName) {
-        HMODULE lib = GetModuleHandleA(moduleName);
-        if (!lib)
-            return false;
+        if (!sym.Resolved.exchange(true, mrks memory_order_acq_rel) && !ptr)
+            MRKLog(concat("Missing mono symbol ", sym.Name));
 
-        for (mrku32 idx = 0; idx < MONO_FUNCTION_COUNT; idx++) {
-            *ms_IndexPointerMapping[idx] = (void*)GetProcAddress(lib, ms_FunctionSyms[idx]);
-        }
+        //the table keeps the miss so it shows up in the symbol report
+        return ptr ? ptr : ms_MonoFallbacks[idx];
+    }
 
-        return true;
-	}
+    inline void* MRKMonoGet(mrku32 idx) {
+        void* ptr = ms_Symbols[idx].Ptr.load(mrks memory_order_acquire);
+        return ptr ? ptr : MRKMonoResolve(idx);
+    }
+
+#define MONO(name) ((MRKMono_##name)MRKMonoGet(MRK_MONO_##name))
+
+    bool MRKMonoInit(const char* moduleName) {
+        ms_Module = MRKModuleOpen(moduleName);
+        return ms_Module != 0;
+    }
 
-    void*** MRKXCPPBackendGetPointers(mrku32* sz) {
-        if (sz)
-            *sz = MONO_FUNCTION_COUNT;
+    mrku32 MRKMonoGetSymbols(MRKXCPPBackendSymbol** syms) {
+        if (syms)
+            *syms = ms_Symbols;
 
-        return ms_IndexPointerMapping;
+        return MRK_MONO_FUNCTION_COUNT;
     }
 
     void MRKMonoThreadAttach() {
         if (!ms_RootDomain)
-            ms_RootDomain = mono_get_root_domain();
+            ms_RootDomain = MONO(mono_get_root_domain)();
 
-        mono_thread_attach(ms_RootDomain);
+        MONO(mono_thread_attach)(ms_RootDomain);
     }
 
     void MRKMonoAssemblyIterator(void* assembly, void*)
@@ -149,79 +195,244 @@ namespace MRK {
         if (ms_CachedImage)
             return;
 
-        void* img = mono_assembly_get_image(assembly);
-        const char* name = (const char*)mono_image_get_name(img);
+        void* img = MONO(mono_assembly_get_image)(assembly);
+        const char* name = MONO(mono_image_get_name)(img);
 
         if (!strcmp(name, ms_CachedImageName)) {
             ms_CachedImage = img;
         }
     }
 
-    void MRKCopyString(char** dest, const char* src) {
-        if (!dest || !src)
+    mrku32 MRKMonoGetTypeKind(void* type) {
+        mrku32 kind = (mrku32)MONO(mono_type_get_type)(type);
+
+        if (kind == MRK_TYPE_VALUETYPE) {
+            void* clazz = MONO(mono_class_from_mono_type)(type);
+            if (MONO(mono_class_is_enum)(clazz))
+                return MRKMonoGetTypeKind(MONO(mono_class_enum_basetype)(clazz));
+        }
+        else if (kind == MRK_TYPE_GENERICINST)
+            return MONO(mono_class_is_valuetype)(MONO(mono_class_from_mono_type)(type)) ? MRK_TYPE_VALUETYPE : MRK_TYPE_CLASS;
+
+        return kind;
+    }
+
+    void MRKMonoResolveType(void* type, MRKXCPPType* mtype) {
+        MRKCopyString(&mtype->Name, MONO(mono_type_get_name)(type), MRK_ALLOC_TYPE);
+        mtype->Kind = MRKMonoGetTypeKind(type);
+        mtype->Size = 0;
+        mtype->FieldCount = 0;
+        mtype->Fields = 0;
+        mtype->Element = 0;
+
+        if (mtype->Kind == MRK_TYPE_SZARRAY) {
+            void* element = MONO(mono_class_get_element_class)(MONO(mono_class_from_mono_type)(type));
+
+            mtype->Element = MRKAllocNew<MRKXCPPType>(MRK_ALLOC_TYPE);
+            MRKMonoResolveType(MONO(mono_class_get_type)(element), mtype->Element);
+            return;
+        }
+
+        if (mtype->Kind != MRK_TYPE_VALUETYPE)
+            return;
+
+        void* clazz = MONO(mono_class_from_mono_type)(type);
+
+        mrku32 align;
+        mtype->Size = (mrku32)MONO(mono_class_value_size)(clazz, &align);
+
+        void* iter = 0;
+        void* field;
+        while ((field = MONO(mono_class_get_fields)(clazz, &iter))) {
+            if (!(MONO(mono_field_get_flags)(field) & FIELD_ATTRIBUTE_STATIC))
+                mtype->FieldCount++;
+        }
+
+        if (!mtype->FieldCount)
+            return;
+
+        mtype->Fields = MRKAllocNewArr<MRKXCPPValueField>(mtype->FieldCount, MRK_ALLOC_TYPE);
+
+        iter = 0;
+        mrku32 idx = 0;
+        while ((field = MONO(mono_class_get_fields)(clazz, &iter))) {
+            if (MONO(mono_field_get_flags)(field) & FIELD_ATTRIBUTE_STATIC)
+                continue;
+
+            //field offsets of value types still count the object header
+            MRKXCPPValueField& vfield = mtype->Fields[idx++];
+            MRKCopyString(&vfield.Name, MONO(mono_field_get_name)(field), MRK_ALLOC_TYPE);
+            vfield.Kind = MRKMonoGetTypeKind(MONO(mono_field_get_type)(field));
+            vfield.Offset = MONO(mono_field_get_offset)(field) - MONO_OBJECT_HEADER_SIZE;
+        }
+    }
+
+    mrku32 MRKMonoGetGenericParams(void* method, mrks string* params) {
+        //generic definitions print as Namespace.Class:Name<T,U>, there is no public accessor for the container
+        char* fullName = MONO(mono_method_full_name)(method, 0);
+        if (!fullName)
+            return 0;
+
+        mrks string key = concat(':', MONO(mono_method_get_name)(method), '<');
+        const char* open = strstr(fullName, key.c_str());
+
+        mrku32 arity = 0;
+        if (open) {
+            arity = 1;
+            for (const char* c = open + key.size(); *c && *c != '>'; c++) {
+                if (*c == ',')
+                    arity++;
+
+                if (params && *c != ' ')
+                    *params += *c;
+            }
+        }
+
+        MONO(mono_free)(fullName);
+        return arity;
+    }
+
+    bool MRKMonoMatchAccessor(const unsigned char* code, mrku32 size, bool setter, mrku32* token) {
+        //release builds: ldarg.0 ldfld f ret / ldarg.0 ldarg.1 stfld f ret.
+        //debug builds lead with a nop and spill the getter's result to a local first: stloc.0 br.s 0 ldloc.0 ret
+        const unsigned char* end = code + size;
+        while (code < end && *code == 0x00)
+            code++;
+
+        static const unsigned char getterHead[] = { 0x02, 0x7B };
+        static const unsigned char setterHead[] = { 0x02, 0x03, 0x7D };
+        static const unsigned char debugTail[] = { 0x0A, 0x2B, 0x00, 0x06, 0x2A };
+
+        const unsigned char* head = setter ? setterHead : getterHead;
+        mrku32 headSize = setter ? sizeof(setterHead) : sizeof(getterHead);
+        if ((mrku32)(end - code) < headSize + 5 || memcmp(code, head, headSize))
+            return false;
+
+        code += headSize;
+        memcpy(token, code, 4); //little endian in the IL stream
+        code += 4;
+
+        mrku32 tail = end - code;
+        if (tail == 1 && *code == 0x2A)
+            return true;
+
+        return !setter && tail == sizeof(debugTail) && !memcmp(code, debugTail, sizeof(debugTail));
+    }
+
+    void MRKMonoResolveBackingField(void* method, MRKXCPPMethod* mmethod, mrku32 flags) {
+        //auto-properties and the like, only the instance field of the method's own class is accepted
+        mmethod->BackingField = 0;
+
+        if (mmethod->ICall || (flags & METHOD_ATTRIBUTE_STATIC) || mmethod->ParamCount > 1)
+            return;
+
+        void* header = MONO(mono_method_get_header)(method);
+        if (!header)
+            return;
+
+        mrku32 codeSize, maxStack, token;
+        const unsigned char* code = MONO(mono_method_header_get_code)(header, &codeSize, &maxStack);
+        bool matched = code && MRKMonoMatchAccessor(code, codeSize, mmethod->ParamCount == 1, &token);
+        MONO(mono_metadata_free_mh)(header);
+
+        //field defs only, a member ref points into another (possibly generic) class
+        if (!matched || (token >> 24) != 0x04)
+            return;
+
+        void* field = MONO(mono_class_get_field)(MONO(mono_method_get_class)(method), token);
+        if (!field || (MONO(mono_field_get_flags)(field) & FIELD_ATTRIBUTE_STATIC))
             return;
 
-        mrku32 nLen = strlen(src);
-        *dest = MRKAllocNewArr<char>(nLen + 1);
-        strcpy(*dest, src);
-        (*dest)[nLen] = '\0';
+        MRKCopyString(&mmethod->BackingField, MONO(mono_field_get_name)(field), MRK_ALLOC_METHOD);
     }
 
-    MRKXCPPImage* MRKXCPPBackendGetImage(const char* name) {
+    MRKXCPPImage* MRKMonoGetImage(const char* name) {
         MRKMonoThreadAttach();
 
         ms_CachedImageName = name;
         ms_CachedImage = 0;
-        mono_assembly_foreach(MRKMonoAssemblyIterator, 0);
+        MONO(mono_assembly_foreach)(MRKMonoAssemblyIterator, 0);
 
         if (!ms_CachedImage)
             return 0;
 
-        MRKXCPPImage* image = MRKAllocNew<MRKXCPPImage>();
+        MRKXCPPImage* image = MRKAllocNew<MRKXCPPImage>(MRK_ALLOC_IMAGE);
         image->Ptr = ms_CachedImage;
 
-        MRKCopyString(&image->Name, name);
+        MRKCopyString(&image->Name, name, MRK_ALLOC_IMAGE);
+        image->Mvid = 0;
+        MRKCopyString(&image->Mvid, MONO(mono_image_get_guid)(ms_CachedImage), MRK_ALLOC_IMAGE);
 
         return image;
     }
 
-    MRKXCPPClass* MRKXCPPBackendGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
+    MRKXCPPClass* MRKMonoGetClass(MRKXCPPImage* image, const char* namespaze, const char* name) {
         MRKMonoThreadAttach();
 
         if (!image)
             return 0;
 
-        void* clazz = mono_class_from_name(image->Ptr, namespaze, name);
+        void* clazz = MONO(mono_class_from_name)(image->Ptr, namespaze, name);
         if (!clazz)
             return 0;
 
-        MRKXCPPClass* mclass = MRKAllocNew<MRKXCPPClass>();
+        MRKXCPPClass* mclass = MRKAllocNew<MRKXCPPClass>(MRK_ALLOC_CLASS);
         mclass->Ptr = clazz;
         mclass->Image = image;
 
-        MRKCopyString(&mclass->Namespace, namespaze);
-        MRKCopyString(&mclass->Name, name);
+        MRKCopyString(&mclass->Namespace, namespaze, MRK_ALLOC_CLASS);
+        MRKCopyString(&mclass->Name, name, MRK_ALLOC_CLASS);
+
+        MRKMonoResolveType(MONO(mono_class_get_type)(clazz), &mclass->Type);
+        mclass->Token = MONO(mono_class_get_type_token)(clazz);
+
+        //every delegate type derives straight from MulticastDelegate
+        void* parent = MONO(mono_class_get_parent)(clazz);
+        mclass->Delegate = parent && !strcmp(MONO(mono_class_get_namespace)(parent), "System")
+            && !strcmp(MONO(mono_class_get_name)(parent), "MulticastDelegate");
+
+        //the whole chain, the generator derives from whichever ancestor is bound closest
+        mrks string parents;
+        for (; parent; parent = MONO(mono_class_get_parent)(parent))
+            concat_into(parents, parents.empty() ? "" : ",", MONO(mono_class_get_namespace)(parent), '.', MONO(mono_class_get_name)(parent));
+
+        mclass->Parents = 0;
+        if (!parents.empty())
+            MRKCopyString(&mclass->Parents, parents.c_str(), MRK_ALLOC_CLASS);
+
+        //generic definitions are named List`1<T>, keep the parameter names to map generic parameters back to their index
+        mclass->GenericParams = 0;
+
+        const char* open = strchr(mclass->Type.Name, '<');
+        if (strchr(name, '`') && open) {
+            mrks string params;
+            for (const char* c = open + 1; *c && *c != '>'; c++) {
+                if (*c != ' ')
+                    params += *c;
+            }
+
+            MRKCopyString(&mclass->GenericParams, params.c_str(), MRK_ALLOC_CLASS);
+        }
 
         return mclass;
     }
 
-    MRKXCPPMethod* MRKXCPPBackendGetMethod(MRKXCPPClass* clazz, const char* name, int argc, int occ) {
+    MRKXCPPMethod* MRKMonoGetMethod(MRKXCPPClass* clazz, const char* name, int argc, int occ) {
         MRKMonoThreadAttach();
 
         if (!clazz)
             return 0;
 
         void* method = 0;
-        void* __sig = 0;
         if (occ == 1)
-            method = mono_class_get_method_from_name(clazz->Ptr, name, argc);
+            method = MONO(mono_class_get_method_from_name)(clazz->Ptr, name, argc);
         else {
             void* iter = 0;
             int _occ = 0;
-            while (method = mono_class_get_methods(clazz->Ptr, &iter)) {
-                void* __sig = mono_method_signature(method);
-                if (!strcmp((const char*)mono_method_get_name(method), name) && 
-                    (mrku32)mono_signature_get_param_count(__sig) == argc) {
+            while ((method = MONO(mono_class_get_methods)(clazz->Ptr, &iter))) {
+                void* __sig = MONO(mono_method_signature)(method);
+                if (!strcmp(MONO(mono_method_get_name)(method), name) && 
+                    MONO(mono_signature_get_param_count)(__sig) == (mrku32)argc) {
                     _occ++;
 
                     if (_occ == occ)
@@ -233,45 +444,176 @@ namespace MRK {
         if (!method)
             return 0;
 
-        MRKXCPPMethod* mmethod = MRKAllocNew<MRKXCPPMethod>();
+        MRKXCPPMethod* mmethod = MRKAllocNew<MRKXCPPMethod>(MRK_ALLOC_METHOD);
         mmethod->Ptr = method;
         mmethod->Class = clazz;
         mmethod->Occurance = occ;
 
-        MRKCopyString(&mmethod->Name, name);
+        MRKCopyString(&mmethod->Name, name, MRK_ALLOC_METHOD);
 
-        void* sig = mono_method_signature(method);
-        mmethod->ParamCount = (mrku32)mono_signature_get_param_count(sig);
-        mmethod->Params = MRKAllocNewArr<char*>(mmethod->ParamCount);
+        //lookups by name also find methods a base class declares, their token is only valid in the declaring image
+        void* declaring = MONO(mono_method_get_class)(method);
+        mmethod->Token = MONO(mono_class_get_image)(declaring) == MONO(mono_class_get_image)(clazz->Ptr) ?
+            MONO(mono_method_get_token)(method) : 0;
+
+        mrku32 iflags;
+        mrku32 flags = MONO(mono_method_get_flags)(method, &iflags);
+        mmethod->ICall = iflags & METHOD_IMPL_ATTRIBUTE_INTERNAL_CALL;
+        mmethod->Virtual = (flags & METHOD_ATTRIBUTE_VIRTUAL) && !(flags & (METHOD_ATTRIBUTE_FINAL | METHOD_ATTRIBUTE_STATIC));
+
+        mmethod->DeclaringClass = MRKXCPPGetName(MRKXCPPInternName(
+            concat(MONO(mono_class_get_namespace)(declaring), '.', MONO(mono_class_get_name)(declaring)).c_str()));
+
+        void* sig = MONO(mono_method_signature)(method);
+        mmethod->ParamCount = MONO(mono_signature_get_param_count)(sig);
+        mmethod->Params = MRKAllocNewArr<char*>(mmethod->ParamCount, MRK_ALLOC_PARAMS);
+        mmethod->ParamTypes = MRKAllocNewArr<MRKXCPPType>(mmethod->ParamCount, MRK_ALLOC_PARAMS);
 
         void* typeiter = 0;
         void* currentType = 0;
         mrku32 idx = 0;
-        while (currentType = mono_signature_get_params(sig, &typeiter)) {
-            MRKCopyString(&mmethod->Params[idx++], (char*)mono_type_get_name(currentType));
+        while ((currentType = MONO(mono_signature_get_params)(sig, &typeiter))) {
+            mmethod->Params[idx] = (char*)MRKXCPPGetName(MRKXCPPInternName(MONO(mono_type_get_name)(currentType)));
+            MRKMonoResolveType(currentType, &mmethod->ParamTypes[idx++]);
         }
 
+        MRKMonoResolveType(MONO(mono_signature_get_return_type)(sig), &mmethod->ReturnType);
+
+        mrks string genericParams;
+        mmethod->GenericParams = 0;
+
+        if (MRKMonoGetGenericParams(method, &genericParams))
+            MRKCopyString(&mmethod->GenericParams, genericParams.c_str(), MRK_ALLOC_METHOD);
+
+        MRKMonoResolveBackingField(method, mmethod, flags);
+
         return mmethod;
     }
 
-    MRKXCPPField* MRKXCPPBackendGetField(MRKXCPPClass* clazz, const char* name) {
+    MRKXCPPField* MRKMonoGetField(MRKXCPPClass* clazz, const char* name) {
         MRKMonoThreadAttach();
 
         if (!clazz)
             return 0;
 
-        void* field = mono_class_get_field_from_name(clazz->Ptr, name);
+        void* field = MONO(mono_class_get_field_from_name)(clazz->Ptr, name);
         if (!field)
             return 0;
 
-        MRKXCPPField* mfield = MRKAllocNew<MRKXCPPField>();
+        MRKXCPPField* mfield = MRKAllocNew<MRKXCPPField>(MRK_ALLOC_FIELD);
         mfield->Ptr = field;
         mfield->Class = clazz;
 
-        MRKCopyString(&mfield->Name, name);
+        MRKCopyString(&mfield->Name, name, MRK_ALLOC_FIELD);
+        //inherited fields as well, 0 binds them by name
+        mfield->Token = MONO(mono_class_get_image)(MONO(mono_field_get_parent)(field)) == MONO(mono_class_get_image)(clazz->Ptr) ?
+            MONO(mono_class_get_field_token)(field) : 0;
+
+        mrku32 flags = MONO(mono_field_get_flags)(field);
+        mfield->Static = (flags & FIELD_ATTRIBUTE_STATIC) && !(flags & FIELD_ATTRIBUTE_LITERAL);
+
+        //thread and context statics (offset -1) live outside the static data and stay on the field value path
+        if (mfield->Static && MONO(mono_field_get_offset)(field) == (mrku32)-1)
+            mfield->Static = false;
+
+        MRKMonoResolveType(MONO(mono_field_get_type)(field), &mfield->Type);
 
         return mfield;
     }
+
+    mrku32 MRKMonoGetClassCount(MRKXCPPImage* image) {
+        MRKMonoThreadAttach();
+
+        if (!image)
+            return 0;
+
+        return (mrku32)MONO(mono_image_get_table_rows)(image->Ptr, MONO_TABLE_TYPEDEF);
+    }
+
+    bool MRKMonoGetClassInfo(MRKXCPPImage* image, mrku32 idx, MRKXCPPMemberInfo* info) {
+        if (!image || !info)
+            return false;
+
+        //typedef rows are 1-based, row 1 being <Module>
+        void* clazz = MONO(mono_class_get)(image->Ptr, MONO_TOKEN_TYPE_DEF | (idx + 1));
+        if (!clazz)
+            return false;
+
+        mrku32 flags = MONO(mono_class_get_flags)(clazz);
+
+        info->Namespace = MONO(mono_class_get_namespace)(clazz);
+        info->Name = MONO(mono_class_get_name)(clazz);
+        info->ParamCount = 0;
+        info->GenericArity = 0;
+        info->Static = false;
+        info->Public = (flags & TYPE_ATTRIBUTE_VISIBILITY_MASK) == TYPE_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    bool MRKMonoNextMethod(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+        if (!clazz || !info)
+            return false;
+
+        void* method = MONO(mono_class_get_methods)(clazz->Ptr, iter);
+        if (!method)
+            return false;
+
+        mrku32 iflags;
+        mrku32 flags = MONO(mono_method_get_flags)(method, &iflags);
+
+        info->Namespace = clazz->Namespace;
+        info->Name = MONO(mono_method_get_name)(method);
+        info->ParamCount = MONO(mono_signature_get_param_count)(MONO(mono_method_signature)(method));
+        info->GenericArity = MRKMonoGetGenericParams(method, 0);
+        info->Static = flags & METHOD_ATTRIBUTE_STATIC;
+        info->Public = (flags & METHOD_ATTRIBUTE_MEMBER_ACCESS_MASK) == METHOD_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    bool MRKMonoNextField(MRKXCPPClass* clazz, void** iter, MRKXCPPMemberInfo* info) {
+        if (!clazz || !info)
+            return false;
+
+        void* field;
+        mrku32 flags;
+        do {
+            field = MONO(mono_class_get_fields)(clazz->Ptr, iter);
+            if (!field)
+                return false;
+
+            flags = MONO(mono_field_get_flags)(field);
+        } while (flags & FIELD_ATTRIBUTE_LITERAL); //constants have no storage to bind to
+
+        info->Namespace = clazz->Namespace;
+        info->Name = MONO(mono_field_get_name)(field);
+        info->ParamCount = 0;
+        info->GenericArity = 0;
+        info->Static = flags & FIELD_ATTRIBUTE_STATIC;
+        info->Public = (flags & FIELD_ATTRIBUTE_FIELD_ACCESS_MASK) == FIELD_ATTRIBUTE_PUBLIC;
+
+        return true;
+    }
+
+    MRKXCPPBackendInterface ms_MonoBackend = {
+        "Mono",
+        MONO_MODULE_NAME,
+        MRKMonoInit,
+        MRKMonoGetSymbols,
+        MRKMonoGetImage,
+        MRKMonoGetClass,
+        MRKMonoGetMethod,
+        MRKMonoGetField,
+        MRKMonoGetClassCount,
+        MRKMonoGetClassInfo,
+        MRKMonoNextMethod,
+        MRKMonoNextField
+    };
+
+    MRKXCPPBackendInterface* MRKXCPPBackendMono() {
+        return &ms_MonoBackend;
+    }
 }
 
 #endif
\ No newline at end of file
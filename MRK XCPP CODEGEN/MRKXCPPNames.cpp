@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MRKXCPPNames.h"
+#include "MRKAlloc.hpp"
+#include "MRKLog.h"
+#include "Concat.hpp"
+
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+#define MRK_NAME_CHUNK_SIZE 0x10000
+#define MRK_NAME_BLOCK_SIZE 0x1000
+#define MRK_NAME_BLOCK_COUNT 0x1000
+
+namespace MRK {
+    //names live in fixed chunks that never move (nor get freed), the lookup keys view straight into them
+    char* ms_NameChunk;
+    mrku32 ms_NameChunkUsed = MRK_NAME_CHUNK_SIZE;
+    mrks unordered_map<mrks string_view, mrku32> ms_NameIds;
+    mrku32ptr ms_NameBucketBytes; //reported size of ms_NameIds' bucket array
+
+    //id -> name in fixed blocks so MRKXCPPGetName reads without locking while other threads intern
+    const char** ms_NameBlocks[MRK_NAME_BLOCK_COUNT];
+    mrks atomic<mrku32> ms_NameCount;
+
+    //writers only, the caches resolve on several threads at once
+    mrks mutex ms_NamesLock;
+    bool ms_NamesFull;
+
+    mrku32 MRKInternName(const char* name) {
+        //ms_NamesLock held
+        if (!name)
+            name = "";
+
+        mrks string_view view(name);
+        auto it = ms_NameIds.find(view);
+        if (it != ms_NameIds.end())
+            return it->second;
+
+        //every id is taken, handing out one already in use would alias two names
+        mrku32 id = ms_NameCount.load(mrks memory_order_relaxed);
+        if (id == MRK_NAME_BLOCK_SIZE * MRK_NAME_BLOCK_COUNT)
+            return MRK_XCPP_NAME_INVALID;
+
+        mrku32 sz = (mrku32)view.size() + 1;
+        char* dest;
+        if (sz > MRK_NAME_CHUNK_SIZE / 4) {
+            //oversized names get their own block so they do not waste the current chunk
+            dest = new char[sz];
+            MRKAllocTrack(MRK_ALLOC_NAME, sz);
+        }
+        else {
+            if (ms_NameChunkUsed + sz > MRK_NAME_CHUNK_SIZE) {
+                ms_NameChunk = new char[MRK_NAME_CHUNK_SIZE];
+                ms_NameChunkUsed = 0;
+
+                MRKAllocTrack(MRK_ALLOC_NAME, MRK_NAME_CHUNK_SIZE);
+            }
+
+            dest = ms_NameChunk + ms_NameChunkUsed;
+            ms_NameChunkUsed += sz;
+        }
+
+        memcpy(dest, name, sz);
+
+        const char**& block = ms_NameBlocks[id / MRK_NAME_BLOCK_SIZE];
+        if (!block) {
+            block = new const char* [MRK_NAME_BLOCK_SIZE];
+            MRKAllocTrack(MRK_ALLOC_NAME, sizeof(const char*) * MRK_NAME_BLOCK_SIZE);
+        }
+
+        block[id % MRK_NAME_BLOCK_SIZE] = dest;
+
+        //the lookup's nodes (entry, next and cached hash) and bucket array, as the standard library lays them out
+        ms_NameIds.emplace(mrks string_view(dest, sz - 1), id);
+        MRKAllocTrack(MRK_ALLOC_NAME, sizeof(decltype(ms_NameIds)::value_type) + sizeof(void*) + sizeof(size_t));
+
+        mrku32ptr bucketBytes = ms_NameIds.bucket_count() * sizeof(void*);
+        if (bucketBytes != ms_NameBucketBytes) {
+            if (ms_NameBucketBytes)
+                MRKAllocUntrack(MRK_ALLOC_NAME, ms_NameBucketBytes);
+
+            MRKAllocTrack(MRK_ALLOC_NAME, bucketBytes);
+            ms_NameBucketBytes = bucketBytes;
+        }
+
+        //publishes the slot, ids are only handed out after this
+        ms_NameCount.store(id + 1, mrks memory_order_release);
+        return id;
+    }
+
+    mrku32 MRKXCPPInternName(const char* name) {
+        mrks lock_guard<mrks mutex> lock(ms_NamesLock);
+
+        mrku32 id = MRKInternName(name);
+        if (id == MRK_XCPP_NAME_INVALID && !ms_NamesFull) {
+            ms_NamesFull = true;
+            MRKLog(concat("Name table full (", MRK_NAME_BLOCK_SIZE * MRK_NAME_BLOCK_COUNT, " names), members with new names are skipped"));
+        }
+
+        return id;
+    }
+
+    const char* MRKXCPPGetName(mrku32 id) {
+        return id < ms_NameCount.load(mrks memory_order_acquire) ? ms_NameBlocks[id / MRK_NAME_BLOCK_SIZE][id % MRK_NAME_BLOCK_SIZE] : 0;
+    }
+
+    mrku32 MRKXCPPGetNameCount() {
+        return ms_NameCount.load(mrks memory_order_acquire);
+    }
+}
@@ -0,0 +1,951 @@
+/*
+ * Copyright (c) 2020, Mohamed Ammar <mamar452@gmail.com>
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+//Support code for the generated bindings, NOT compiled into the codegen itself.
+//Ships in the generated root next to MRKXCPPGen.h, which provides E(), N(), __protect()/__end()
+//and the MRKRuntime* calls. The MRKRuntime* hooks declared below are implemented by the same runtime.
+
+#pragma once
+
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+#include <utility>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+//member binding, by metadata token when the loaded module has the mvid the bindings were generated from, by name otherwise
+void* MRKRuntimeGetImage(const char* name, const char* mvid); //0 unless loaded with a matching mvid
+void* MRKRuntimeResolveToken(void* image, unsigned int token); //class, method or field depending on the token's table
+void* MRKRuntimeGetMethod(void* clazz, const char* name, unsigned int argc, int occ);
+void* MRKRuntimeGetField(void* clazz, const char* name);
+void* MRKRuntimeInvokeMethod(void* method, void* instance, void** args, bool sttic);
+
+//internal calls, the runtime's native implementation of a method or 0 to keep going through the managed wrapper
+void* MRKRuntimeGetICall(void* method);
+
+//il2cpp, the native code a method was compiled to or 0 on runtimes that only invoke (mono)
+void* MRKRuntimeGetMethodPointer(void* method);
+
+//icalls and il2cpp method pointers use the platform's default c calling convention, instance methods take the object first
+#if defined(_WIN32) && !defined(_WIN64)
+#define MRK_XCPP_ICALLCALL __cdecl
+#else
+#define MRK_XCPP_ICALLCALL
+#endif
+
+inline void* MRKXCPPBindClass(void* image, unsigned int token, const char* namespaze, const char* name, const char* imageName) {
+	void* clazz = image && token ? MRKRuntimeResolveToken(image, token) : 0;
+	return clazz ? clazz : MRKRuntimeGetClass(namespaze, name, imageName);
+}
+
+inline void* MRKXCPPBindMethod(void* image, unsigned int token, void* clazz, const char* name, unsigned int argc, int occ) {
+	void* method = image && token ? MRKRuntimeResolveToken(image, token) : 0;
+	return method ? method : MRKRuntimeGetMethod(clazz, name, argc, occ);
+}
+
+inline void* MRKXCPPBindField(void* image, unsigned int token, void* clazz, const char* name) {
+	void* field = image && token ? MRKRuntimeResolveToken(image, token) : 0;
+	return field ? field : MRKRuntimeGetField(clazz, name);
+}
+
+//generic classes
+void* MRKRuntimeInflateClass(void* genericClass, void** typeArgs, unsigned int argc);
+
+//managed class of a C++ type argument, generated classes expose theirs through __class
+template<typename T>
+struct MRKXCPPClassOf {
+	static void* Get() { return T::__class; }
+};
+
+#define MRK_XCPP_CORLIB_CLASS(type, name) \
+	template<> \
+	struct MRKXCPPClassOf<type> { \
+		static void* Get() { \
+			static void* clazz = MRKRuntimeGetClass(E("System"), E(name), E("mscorlib")); \
+			return clazz; \
+		} \
+	};
+
+MRK_XCPP_CORLIB_CLASS(bool, "Boolean")
+MRK_XCPP_CORLIB_CLASS(char16_t, "Char")
+MRK_XCPP_CORLIB_CLASS(signed char, "SByte")
+MRK_XCPP_CORLIB_CLASS(unsigned char, "Byte")
+MRK_XCPP_CORLIB_CLASS(short, "Int16")
+MRK_XCPP_CORLIB_CLASS(unsigned short, "UInt16")
+MRK_XCPP_CORLIB_CLASS(int, "Int32")
+MRK_XCPP_CORLIB_CLASS(unsigned int, "UInt32")
+MRK_XCPP_CORLIB_CLASS(long long, "Int64")
+MRK_XCPP_CORLIB_CLASS(unsigned long long, "UInt64")
+//long is its own type, int64_t is long on LP64 and int32_t may be long on LLP64
+#if LONG_MAX == INT_MAX
+MRK_XCPP_CORLIB_CLASS(long, "Int32")
+MRK_XCPP_CORLIB_CLASS(unsigned long, "UInt32")
+#else
+MRK_XCPP_CORLIB_CLASS(long, "Int64")
+MRK_XCPP_CORLIB_CLASS(unsigned long, "UInt64")
+#endif
+MRK_XCPP_CORLIB_CLASS(float, "Single")
+MRK_XCPP_CORLIB_CLASS(double, "Double")
+
+#undef MRK_XCPP_CORLIB_CLASS
+
+template<typename... T>
+void* MRKXCPPInflateClass(void* genericClass) {
+	void* typeArgs[] = { MRKXCPPClassOf<T>::Get()... };
+	return MRKRuntimeInflateClass(genericClass, typeArgs, sizeof...(T));
+}
+
+//generic methods, the definition is inflated once per type argument list and cached by the caller
+void* MRKRuntimeInflateMethod(void* genericMethod, void** typeArgs, unsigned int argc);
+
+template<typename... T>
+void* MRKXCPPInflateMethod(void* genericMethod) {
+	void* typeArgs[] = { MRKXCPPClassOf<T>::Get()... };
+	return MRKRuntimeInflateMethod(genericMethod, typeArgs, sizeof...(T));
+}
+
+//value type returns
+void* MRKRuntimeUnbox(void* boxed);
+void* MRKRuntimeGetThunk(void* method);
+void MRKRuntimeRaise(void* exception);
+
+//unmanaged thunks are stdcall on windows x86, the keyword is ignored elsewhere on windows
+#ifdef _WIN32
+#define MRK_XCPP_THUNKCALL __stdcall
+#else
+#define MRK_XCPP_THUNKCALL
+#endif
+
+template<typename T>
+T MRKXCPPUnbox(void* boxed) {
+	T value{};
+	if (boxed)
+		memcpy(&value, MRKRuntimeUnbox(boxed), sizeof(T));
+
+	return value;
+}
+
+template<typename T>
+T MRKXCPPCallThunk(void* thunk, void* instance, bool sttic) {
+	void* exception = 0;
+	T value = sttic ? ((T(MRK_XCPP_THUNKCALL*)(void**))thunk)(&exception)
+		: ((T(MRK_XCPP_THUNKCALL*)(void*, void**))thunk)(instance, &exception);
+
+	if (exception)
+		MRKRuntimeRaise(exception);
+
+	return value;
+}
+
+//trivial accessors, offset of an instance field from the start of the object, 0 when unknown
+int MRKRuntimeGetFieldOffset(void* field);
+
+//virtual calls
+void* MRKRuntimeGetObjectClass(void* object);
+void* MRKRuntimeGetVirtualMethod(void* object, void* method); //the override object's class runs for method
+
+//what one receiver class runs for one declared method, owned by the call site that resolved it and never freed
+struct MRKXCPPVirtualTarget {
+	void* Class;
+	void* Declared;
+	void* Method;
+	MRKXCPPVirtualTarget* Next; //the site's previously seen receiver classes, immutable once published
+	std::atomic<void*> Thunk{ nullptr };
+	std::atomic<bool> ThunkResolved{ false };
+
+	void* GetThunk() {
+		//resolving twice from racing threads is harmless, both get the same thunk
+		if (!ThunkResolved.load(std::memory_order_acquire)) {
+			Thunk.store(MRKRuntimeGetThunk(Method), std::memory_order_relaxed);
+			ThunkResolved.store(true, std::memory_order_release);
+		}
+
+		return Thunk.load(std::memory_order_relaxed);
+	}
+};
+
+inline MRKXCPPVirtualTarget* MRKXCPPResolveVirtual(void* clazz, void* object, void* method) {
+	//a null receiver keeps the declared method, invoking it raises the NullReferenceException
+	MRKXCPPVirtualTarget* target = new MRKXCPPVirtualTarget;
+	target->Class = clazz;
+	target->Declared = method;
+	target->Method = object ? MRKRuntimeGetVirtualMethod(object, method) : method;
+	target->Next = nullptr;
+
+	if (!target->Method)
+		target->Method = method;
+
+	return target;
+}
+
+//polymorphic inline cache of a virtual call site. the last receiver class is checked first, then every class the site has seen.
+//misses resolve and push onto the site's own list without locking, the list only grows with the receiver classes the site sees
+class MRKXCPPInlineCache {
+private:
+	std::atomic<MRKXCPPVirtualTarget*> m_Last{ nullptr };
+	std::atomic<MRKXCPPVirtualTarget*> m_Seen{ nullptr };
+
+public:
+	MRKXCPPVirtualTarget* Lookup(void* instance, void* method) {
+		void* clazz = instance ? MRKRuntimeGetObjectClass(instance) : 0;
+
+		MRKXCPPVirtualTarget* target = m_Last.load(std::memory_order_acquire);
+		if (target && target->Class == clazz && target->Declared == method)
+			return target;
+
+		for (target = m_Seen.load(std::memory_order_acquire); target; target = target->Next) {
+			if (target->Class == clazz && target->Declared == method) {
+				m_Last.store(target, std::memory_order_release);
+				return target;
+			}
+		}
+
+		//threads missing on the same class at once may both push, either entry answers later lookups
+		target = MRKXCPPResolveVirtual(clazz, instance, method);
+		MRKXCPPVirtualTarget* head = m_Seen.load(std::memory_order_relaxed);
+		do {
+			target->Next = head;
+		} while (!m_Seen.compare_exchange_weak(head, target, std::memory_order_release, std::memory_order_relaxed));
+
+		m_Last.store(target, std::memory_order_release);
+		return target;
+	}
+};
+
+//static fields, the address inside the class' static data (vtable) once the class is initialized
+void* MRKRuntimeGetStaticFieldAddress(void* clazz, void* field);
+
+//the storage of a static field, which stays null when its class or the field failed to bind
+template<typename T>
+T& MRKXCPPStaticField(T* addr, const char* name) {
+	if (!addr)
+		throw std::runtime_error(std::string("MRKXCPP: static field not bound: ") + name);
+
+	return *addr;
+}
+
+//what a slot typed by T holds: a generated class exposes it as __storage, primitives hold themselves
+template<typename T>
+struct MRKXCPPStorageOf {
+	typedef typename T::__storage Type;
+};
+
+#define MRK_XCPP_PRIMITIVE_STORAGE(type) \
+	template<> \
+	struct MRKXCPPStorageOf<type> { \
+		typedef type Type; \
+	};
+
+MRK_XCPP_PRIMITIVE_STORAGE(bool)
+MRK_XCPP_PRIMITIVE_STORAGE(char16_t)
+MRK_XCPP_PRIMITIVE_STORAGE(signed char)
+MRK_XCPP_PRIMITIVE_STORAGE(unsigned char)
+MRK_XCPP_PRIMITIVE_STORAGE(short)
+MRK_XCPP_PRIMITIVE_STORAGE(unsigned short)
+MRK_XCPP_PRIMITIVE_STORAGE(int)
+MRK_XCPP_PRIMITIVE_STORAGE(unsigned int)
+MRK_XCPP_PRIMITIVE_STORAGE(long long)
+MRK_XCPP_PRIMITIVE_STORAGE(unsigned long long)
+MRK_XCPP_PRIMITIVE_STORAGE(long)
+MRK_XCPP_PRIMITIVE_STORAGE(unsigned long)
+MRK_XCPP_PRIMITIVE_STORAGE(float)
+MRK_XCPP_PRIMITIVE_STORAGE(double)
+
+#undef MRK_XCPP_PRIMITIVE_STORAGE
+
+//zero-copy view over a managed T[], holds nothing but the array object so it can alias a slot.
+//mono and il2cpp share the layout: object header (2 pointers), bounds, max_length, then the elements
+template<typename T>
+struct MRKXCPPArray {
+	void* Object;
+
+	MRKXCPPArray(void* object = 0) : Object(object) {}
+
+	operator void*() const {
+		return Object;
+	}
+
+	uintptr_t Length() const {
+		return Object ? *(uintptr_t*)((char*)Object + 3 * sizeof(void*)) : 0;
+	}
+
+	T* Data() const {
+		return Object ? (T*)((char*)Object + 4 * sizeof(void*)) : 0;
+	}
+
+	T& operator[](uintptr_t idx) const {
+		return Data()[idx];
+	}
+
+	T* begin() const {
+		return Data();
+	}
+
+	T* end() const {
+		return Data() + Length();
+	}
+};
+
+//string parameters
+void* MRKRuntimeNewString(const char* utf8, unsigned int length);
+unsigned int MRKRuntimeGCHandleNew(void* object, bool pinned);
+void MRKRuntimeGCHandleFree(unsigned int handle);
+
+#ifndef MRK_XCPP_STRING_CACHE_SIZE
+#define MRK_XCPP_STRING_CACHE_SIZE 256
+#endif
+
+//bounded LRU of interned managed strings keyed by content hash, entries are pinned so the cached object never moves.
+//a string returned by Get stays valid until MRK_XCPP_STRING_CACHE_SIZE other distinct strings went through the cache
+class MRKXCPPStringCache {
+	struct Entry {
+		uint64_t Hash;
+		std::string Text;
+		unsigned int Handle;
+		void* Object;
+		Entry* Prev;
+		Entry* Next;
+	};
+
+	Entry m_Entries[MRK_XCPP_STRING_CACHE_SIZE];
+	unsigned int m_Used;
+	Entry* m_Head; //most recently used
+	Entry* m_Tail;
+	std::unordered_map<uint64_t, Entry*> m_Lookup;
+	std::mutex m_Lock;
+
+	static uint64_t Hash(std::string_view text) {
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : text) {
+			hash ^= (unsigned char)c;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	void Unlink(Entry* entry) {
+		(entry->Prev ? entry->Prev->Next : m_Head) = entry->Next;
+		(entry->Next ? entry->Next->Prev : m_Tail) = entry->Prev;
+	}
+
+	void PushFront(Entry* entry) {
+		entry->Prev = 0;
+		entry->Next = m_Head;
+		(m_Head ? m_Head->Prev : m_Tail) = entry;
+		m_Head = entry;
+	}
+
+public:
+	MRKXCPPStringCache() : m_Entries(), m_Used(0), m_Head(0), m_Tail(0) {
+		m_Lookup.reserve(MRK_XCPP_STRING_CACHE_SIZE);
+	}
+
+	static MRKXCPPStringCache& Instance() {
+		static MRKXCPPStringCache cache;
+		return cache;
+	}
+
+	void* Get(std::string_view text) {
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		uint64_t hash = Hash(text);
+		auto it = m_Lookup.find(hash);
+
+		Entry* entry;
+		if (it != m_Lookup.end()) {
+			entry = it->second;
+			Unlink(entry);
+
+			if (entry->Text == text) {
+				PushFront(entry);
+				return entry->Object;
+			}
+
+			//hash collision, the entry is recycled for the new text
+			MRKRuntimeGCHandleFree(entry->Handle);
+		}
+		else if (m_Used < MRK_XCPP_STRING_CACHE_SIZE)
+			entry = &m_Entries[m_Used++];
+		else {
+			entry = m_Tail;
+			Unlink(entry);
+
+			m_Lookup.erase(entry->Hash);
+			MRKRuntimeGCHandleFree(entry->Handle);
+		}
+
+		entry->Hash = hash;
+		entry->Text.assign(text.data(), text.size());
+		entry->Object = MRKRuntimeNewString(text.data(), (unsigned int)text.size());
+		entry->Handle = MRKRuntimeGCHandleNew(entry->Object, true);
+
+		m_Lookup[hash] = entry;
+		PushFront(entry);
+
+		return entry->Object;
+	}
+};
+
+inline void* MRKXCPPString(std::string_view text) {
+	return MRKXCPPStringCache::Instance().Get(text);
+}
+
+//non-const char* converts to void* ahead of std::string_view, generated text overloads take C* constrained to char instead.
+//deduction fails for null and void*, which keep going to the object overload
+template<typename C>
+using MRKXCPPIfChar = typename std::enable_if<std::is_same<C, char>::value, int>::type;
+
+//zero-copy view over a managed System.String, valid for as long as the string is reachable and pinned (or the GC is non-moving).
+//mono and il2cpp share the layout: object header (2 pointers), int32 length, then the UTF-16 characters
+struct MRKXCPPStringView {
+	void* Object;
+
+	MRKXCPPStringView(void* object = 0) : Object(object) {}
+
+	operator void*() const {
+		return Object;
+	}
+
+	unsigned int Length() const {
+		return Object ? *(int*)((char*)Object + 2 * sizeof(void*)) : 0;
+	}
+
+	const char16_t* Data() const {
+		return Object ? (const char16_t*)((char*)Object + 2 * sizeof(void*) + sizeof(int)) : u"";
+	}
+
+	std::u16string_view View() const {
+		return std::u16string_view(Data(), Length());
+	}
+
+	//appends the UTF-8 form to out, which keeps its capacity when reused
+	void ToUTF8(std::string& out) const {
+		const char16_t* src = Data();
+		unsigned int len = Length();
+
+		size_t at = out.size();
+		out.resize(at + len * 3); //worst case, a BMP character takes 3 bytes and a surrogate pair 4 for 2 units
+		char* dst = &out[0] + at;
+
+		unsigned int idx = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		//8 characters at a time for as long as they are ASCII
+		const __m128i nonAscii = _mm_set1_epi16((short)0xFF80);
+		for (; idx + 8 <= len; idx += 8) {
+			__m128i chars = _mm_loadu_si128((const __m128i*)(src + idx));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAscii), _mm_setzero_si128())) != 0xFFFF)
+				break;
+
+			_mm_storel_epi64((__m128i*)dst, _mm_packus_epi16(chars, chars));
+			dst += 8;
+		}
+#endif
+
+		for (; idx < len; idx++) {
+			unsigned int c = src[idx];
+
+			if (c >= 0xD800 && c <= 0xDBFF && idx + 1 < len && src[idx + 1] >= 0xDC00 && src[idx + 1] <= 0xDFFF)
+				c = 0x10000 + ((c - 0xD800) << 10) + (src[++idx] - 0xDC00);
+
+			if (c < 0x80)
+				*dst++ = (char)c;
+			else if (c < 0x800) {
+				*dst++ = (char)(0xC0 | (c >> 6));
+				*dst++ = (char)(0x80 | (c & 0x3F));
+			}
+			else if (c < 0x10000) {
+				*dst++ = (char)(0xE0 | (c >> 12));
+				*dst++ = (char)(0x80 | ((c >> 6) & 0x3F));
+				*dst++ = (char)(0x80 | (c & 0x3F));
+			}
+			else {
+				*dst++ = (char)(0xF0 | (c >> 18));
+				*dst++ = (char)(0x80 | ((c >> 12) & 0x3F));
+				*dst++ = (char)(0x80 | ((c >> 6) & 0x3F));
+				*dst++ = (char)(0x80 | (c & 0x3F));
+			}
+		}
+
+		out.resize(dst - out.data());
+	}
+
+	std::string ToUTF8() const {
+		std::string out;
+		ToUTF8(out);
+		return out;
+	}
+};
+
+//long lived references
+void* MRKRuntimeNewObjectArray(unsigned int length);
+void* MRKRuntimeGCHandleGetTarget(unsigned int handle);
+void MRKRuntimeArraySetRef(void* array, unsigned int index, void* object);
+
+#ifndef MRK_XCPP_HANDLE_SLAB_SIZE
+#define MRK_XCPP_HANDLE_SLAB_SIZE 256
+#endif
+
+#ifndef MRK_XCPP_HANDLE_SLAB_MAX
+#define MRK_XCPP_HANDLE_SLAB_MAX 4096
+#endif
+
+//references are parked in slots of managed object[] slabs, one GC handle keeps a whole slab alive.
+//a slot id is slab * MRK_XCPP_HANDLE_SLAB_SIZE + index + 1 so that 0 stays the empty handle, released slots are reused first
+class MRKXCPPHandlePool {
+	unsigned int m_Slabs[MRK_XCPP_HANDLE_SLAB_MAX]; //written once under the lock before any of their slots is handed out
+	unsigned int m_SlabCount;
+	std::vector<unsigned int> m_Free;
+	std::mutex m_Lock;
+
+	void* Slab(unsigned int slot) const {
+		return MRKRuntimeGCHandleGetTarget(m_Slabs[(slot - 1) / MRK_XCPP_HANDLE_SLAB_SIZE]);
+	}
+
+public:
+	MRKXCPPHandlePool() : m_Slabs(), m_SlabCount(0) {
+	}
+
+	static MRKXCPPHandlePool& Instance() {
+		static MRKXCPPHandlePool pool;
+		return pool;
+	}
+
+	unsigned int Acquire(void* object) {
+		if (!object)
+			return 0;
+
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		if (m_Free.empty()) {
+			if (m_SlabCount == MRK_XCPP_HANDLE_SLAB_MAX)
+				throw std::runtime_error("MRKXCPPHandlePool: out of slabs, raise MRK_XCPP_HANDLE_SLAB_MAX");
+
+			m_Slabs[m_SlabCount] = MRKRuntimeGCHandleNew(MRKRuntimeNewObjectArray(MRK_XCPP_HANDLE_SLAB_SIZE), false);
+
+			unsigned int first = m_SlabCount++ * MRK_XCPP_HANDLE_SLAB_SIZE + 1;
+			for (unsigned int slot = first + MRK_XCPP_HANDLE_SLAB_SIZE; slot-- > first;)
+				m_Free.push_back(slot);
+		}
+
+		unsigned int slot = m_Free.back();
+		m_Free.pop_back();
+
+		MRKRuntimeArraySetRef(Slab(slot), (slot - 1) % MRK_XCPP_HANDLE_SLAB_SIZE, object);
+		return slot;
+	}
+
+	void Release(unsigned int slot) {
+		if (!slot)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		MRKRuntimeArraySetRef(Slab(slot), (slot - 1) % MRK_XCPP_HANDLE_SLAB_SIZE, 0);
+		m_Free.push_back(slot);
+	}
+
+	//current address of the object, re-read on every call since the GC may have moved it
+	void* Get(unsigned int slot) const {
+		return slot ? MRKXCPPArray<void*>(Slab(slot))[(slot - 1) % MRK_XCPP_HANDLE_SLAB_SIZE] : 0;
+	}
+};
+
+//move-only owning reference to a managed object of class T, generated classes expose it as T::__Handle
+template<typename T>
+class MRKXCPPHandle {
+	unsigned int m_Slot;
+
+public:
+	MRKXCPPHandle() : m_Slot(0) {
+	}
+
+	explicit MRKXCPPHandle(void* object) : m_Slot(MRKXCPPHandlePool::Instance().Acquire(object)) {
+	}
+
+	MRKXCPPHandle(MRKXCPPHandle&& other) noexcept : m_Slot(other.m_Slot) {
+		other.m_Slot = 0;
+	}
+
+	MRKXCPPHandle& operator=(MRKXCPPHandle&& other) noexcept {
+		if (this != &other) {
+			Reset();
+
+			m_Slot = other.m_Slot;
+			other.m_Slot = 0;
+		}
+
+		return *this;
+	}
+
+	MRKXCPPHandle(const MRKXCPPHandle&) = delete;
+	MRKXCPPHandle& operator=(const MRKXCPPHandle&) = delete;
+
+	~MRKXCPPHandle() {
+		Reset();
+	}
+
+	void Reset() {
+		MRKXCPPHandlePool::Instance().Release(m_Slot);
+		m_Slot = 0;
+	}
+
+	void* Get() const {
+		return MRKXCPPHandlePool::Instance().Get(m_Slot);
+	}
+
+	operator void*() const {
+		return Get();
+	}
+
+	explicit operator bool() const {
+		return m_Slot != 0;
+	}
+};
+
+//callbacks, a delegate of class delegateClass whose invocation calls straight into the native function (reverse p/invoke)
+void* MRKRuntimeCreateDelegate(void* delegateClass, void* function);
+
+#ifndef MRK_XCPP_CALLBACK_POOL_SIZE
+#define MRK_XCPP_CALLBACK_POOL_SIZE 64
+#endif
+
+//MRK_XCPP_CALLBACK_POOL_SIZE slots per delegate class D and signature, each with its own native thunk and the delegate wrapping it.
+//a slot's delegate is created the first time the slot is used (or by Reserve) and reused by every later registration
+template<typename D, typename Sig>
+class MRKXCPPCallbackPool;
+
+template<typename D, typename R, typename... A>
+class MRKXCPPCallbackPool<D, R(A...)> {
+public:
+	typedef R(*Function)(void* context, A... args);
+
+private:
+	struct Slot {
+		Function Target;
+		void* Context;
+		unsigned int Delegate; //GC handle, 0 until created
+	};
+
+	Slot m_Slots[MRK_XCPP_CALLBACK_POOL_SIZE];
+	std::vector<unsigned int> m_Free;
+	std::mutex m_Lock;
+
+	template<unsigned int I>
+	static R MRK_XCPP_THUNKCALL Thunk(A... args) {
+		Slot& slot = Instance().m_Slots[I];
+		return slot.Target(slot.Context, args...);
+	}
+
+	template<unsigned int... I>
+	static void* ThunkAt(unsigned int idx, std::integer_sequence<unsigned int, I...>) {
+		static void* thunks[] = { (void*)&Thunk<I>... };
+		return thunks[idx];
+	}
+
+	void CreateDelegate(unsigned int idx) {
+		void* thunk = ThunkAt(idx, std::make_integer_sequence<unsigned int, MRK_XCPP_CALLBACK_POOL_SIZE>());
+		m_Slots[idx].Delegate = MRKRuntimeGCHandleNew(MRKRuntimeCreateDelegate(MRKXCPPClassOf<D>::Get(), thunk), false);
+	}
+
+public:
+	MRKXCPPCallbackPool() : m_Slots() {
+		for (unsigned int idx = MRK_XCPP_CALLBACK_POOL_SIZE; idx-- > 0;)
+			m_Free.push_back(idx);
+	}
+
+	static MRKXCPPCallbackPool& Instance() {
+		static MRKXCPPCallbackPool pool;
+		return pool;
+	}
+
+	//creates the delegates of the next count free slots up front, e.g. during loading
+	void Reserve(unsigned int count) {
+		std::lock_guard<std::mutex> lock(m_Lock);
+
+		for (unsigned int i = 0; i < count && i < m_Free.size(); i++) {
+			unsigned int idx = m_Free[m_Free.size() - 1 - i];
+			if (!m_Slots[idx].Delegate)
+				CreateDelegate(idx);
+		}
+	}
+
+	//slot index + 1, 0 once the pool is exhausted
+	unsigned int Acquire(Function target, void* context) {
+		std::lock_guard<std::mutex> lock(m_Lock);
+		if (m_Free.empty())
+			return 0;
+
+		unsigned int idx = m_Free.back();
+		m_Free.pop_back();
+
+		m_Slots[idx].Target = target;
+		m_Slots[idx].Context = context;
+
+		if (!m_Slots[idx].Delegate)
+			CreateDelegate(idx);
+
+		return idx + 1;
+	}
+
+	void Release(unsigned int slot) {
+		if (!slot)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_Lock);
+		m_Free.push_back(slot - 1);
+	}
+
+	void* GetDelegate(unsigned int slot) {
+		return slot ? MRKRuntimeGCHandleGetTarget(m_Slots[slot - 1].Delegate) : 0;
+	}
+};
+
+//move-only registration of a native callback as a delegate of class D, generated delegate classes expose it as D::__Callback.
+//the delegate stays bound to this callback until it is destroyed, unsubscribe it from managed events before that
+template<typename D, typename Sig>
+class MRKXCPPCallback;
+
+template<typename D, typename R, typename... A>
+class MRKXCPPCallback<D, R(A...)> {
+	typedef MRKXCPPCallbackPool<D, R(A...)> Pool;
+
+	unsigned int m_Slot;
+
+	static R CallFunction(void* context, A... args) {
+		return ((R(*)(A...))context)(args...);
+	}
+
+public:
+	MRKXCPPCallback() : m_Slot(0) {
+	}
+
+	MRKXCPPCallback(typename Pool::Function target, void* context) : m_Slot(Pool::Instance().Acquire(target, context)) {
+	}
+
+	MRKXCPPCallback(R(*function)(A...)) : m_Slot(Pool::Instance().Acquire(&CallFunction, (void*)function)) {
+	}
+
+	MRKXCPPCallback(MRKXCPPCallback&& other) noexcept : m_Slot(other.m_Slot) {
+		other.m_Slot = 0;
+	}
+
+	MRKXCPPCallback& operator=(MRKXCPPCallback&& other) noexcept {
+		if (this != &other) {
+			Reset();
+
+			m_Slot = other.m_Slot;
+			other.m_Slot = 0;
+		}
+
+		return *this;
+	}
+
+	MRKXCPPCallback(const MRKXCPPCallback&) = delete;
+	MRKXCPPCallback& operator=(const MRKXCPPCallback&) = delete;
+
+	~MRKXCPPCallback() {
+		Reset();
+	}
+
+	static void Reserve(unsigned int count) {
+		Pool::Instance().Reserve(count);
+	}
+
+	void Reset() {
+		Pool::Instance().Release(m_Slot);
+		m_Slot = 0;
+	}
+
+	void* Delegate() const {
+		return Pool::Instance().GetDelegate(m_Slot);
+	}
+
+	operator void*() const {
+		return Delegate();
+	}
+
+	explicit operator bool() const {
+		return m_Slot != 0;
+	}
+};
+
+//jit warm-up, compiles a method ahead of its first call, 0 when the runtime could not.
+//a background thread has to be attached to the runtime before it calls MRK_XCPP_WARMUP
+void* MRKRuntimeCompileMethod(void* method);
+
+struct MRKXCPPWarmupStats {
+	unsigned int Compiled;
+	unsigned int Failed;
+	long long Micros; //total compile time
+};
+
+//called once per method with its compile time
+typedef void (*MRKXCPPWarmupReport)(const char* name, long long micros, bool compiled);
+
+inline void MRKXCPPWarmupMethod(const char* name, void* method, MRKXCPPWarmupReport report, MRKXCPPWarmupStats& stats) {
+	auto start = std::chrono::steady_clock::now();
+	bool compiled = method && MRKRuntimeCompileMethod(method);
+	long long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	(compiled ? stats.Compiled : stats.Failed)++;
+	stats.Micros += micros;
+
+	if (report)
+		report(name, micros, compiled);
+}
+
+//main thread dispatch, worker threads queue calls that MRKXCPPPump runs on the runtime's main thread
+struct MRKXCPPDispatchNode {
+	std::atomic<MRKXCPPDispatchNode*> Next{ 0 };
+	unsigned int Batch = 0; //pump the node was queued ahead of
+
+	virtual ~MRKXCPPDispatchNode() {}
+	virtual void Run() {}
+};
+
+template<typename R>
+struct MRKXCPPDispatchTask : MRKXCPPDispatchNode {
+	std::packaged_task<R()> Task;
+
+	template<typename F>
+	MRKXCPPDispatchTask(F&& fn) : Task(std::forward<F>(fn)) {}
+
+	void Run() override {
+		Task();
+	}
+};
+
+//intrusive multi producer single consumer queue, a push is one exchange and never waits on the pump or other producers
+class MRKXCPPDispatchQueue {
+	std::atomic<MRKXCPPDispatchNode*> m_Head; //last pushed, producers
+	MRKXCPPDispatchNode* m_Tail; //next to run, the pump only
+	MRKXCPPDispatchNode* m_Held; //popped ahead of its pump, runs first in the next one
+	MRKXCPPDispatchNode m_Stub;
+	std::atomic<unsigned int> m_Batch;
+
+	MRKXCPPDispatchQueue() : m_Head(&m_Stub), m_Tail(&m_Stub), m_Held(0), m_Batch(0) {}
+
+	MRKXCPPDispatchNode* Pop() {
+		MRKXCPPDispatchNode* tail = m_Tail;
+		MRKXCPPDispatchNode* next = tail->Next.load(std::memory_order_acquire);
+		if (tail == &m_Stub) {
+			if (!next)
+				return 0;
+
+			m_Tail = tail = next;
+			next = next->Next.load(std::memory_order_acquire);
+		}
+
+		if (next) {
+			m_Tail = next;
+			return tail;
+		}
+
+		//a producer is between its exchange and linking, it shows up next pump
+		if (tail != m_Head.load(std::memory_order_acquire))
+			return 0;
+
+		//tail is the last node, the stub goes behind it so it can be handed out
+		Push(&m_Stub);
+		next = tail->Next.load(std::memory_order_acquire);
+		if (next) {
+			m_Tail = next;
+			return tail;
+		}
+
+		return 0;
+	}
+
+public:
+	static MRKXCPPDispatchQueue& Instance() {
+		static MRKXCPPDispatchQueue queue;
+		return queue;
+	}
+
+	void Push(MRKXCPPDispatchNode* node) {
+		node->Next.store(0, std::memory_order_relaxed);
+		node->Batch = m_Batch.load(std::memory_order_relaxed);
+		MRKXCPPDispatchNode* prev = m_Head.exchange(node, std::memory_order_acq_rel);
+		prev->Next.store(node, std::memory_order_release);
+	}
+
+	//runs up to max queued calls in order, once per frame from the main thread.
+	//the head can be the recycled stub, so the batch is cut by stamp rather than by node: calls queued
+	//while this pump runs, by the calls themselves included, wait for the next one
+	unsigned int Pump(unsigned int max) {
+		unsigned int batch = m_Batch.fetch_add(1, std::memory_order_relaxed);
+		unsigned int count = 0;
+		while (count < max) {
+			MRKXCPPDispatchNode* node = m_Held ? m_Held : Pop();
+			m_Held = 0;
+			if (!node)
+				break;
+
+			if ((int)(node->Batch - batch) > 0) {
+				m_Held = node;
+				break;
+			}
+
+			node->Run();
+			delete node;
+			count++;
+		}
+
+		return count;
+	}
+};
+
+//queues fn for the main thread, its result or exception comes back through the future.
+//waiting on the future from the main thread itself deadlocks, it only completes in a later pump
+template<typename F>
+auto MRKXCPPDispatch(F&& fn) -> std::future<decltype(fn())> {
+	typedef decltype(fn()) R;
+
+	MRKXCPPDispatchTask<R>* task = new MRKXCPPDispatchTask<R>(std::forward<F>(fn));
+	std::future<R> future = task->Task.get_future();
+	MRKXCPPDispatchQueue::Instance().Push(task);
+	return future;
+}
+
+//drains the calls queued since the last pump as one batch, returns how many ran
+inline unsigned int MRKXCPPPump(unsigned int max = (unsigned int)-1) {
+	return MRKXCPPDispatchQueue::Instance().Pump(max);
+}
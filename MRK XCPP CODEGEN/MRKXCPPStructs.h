@@ -27,9 +27,55 @@
 #pragma once
 
 namespace MRK {
+	//ECMA-335 element types, enums are reported as their underlying type
+	enum MRKXCPPTypeKind {
+		MRK_TYPE_VOID = 0x01,
+		MRK_TYPE_BOOLEAN = 0x02,
+		MRK_TYPE_CHAR = 0x03,
+		MRK_TYPE_I1 = 0x04,
+		MRK_TYPE_U1 = 0x05,
+		MRK_TYPE_I2 = 0x06,
+		MRK_TYPE_U2 = 0x07,
+		MRK_TYPE_I4 = 0x08,
+		MRK_TYPE_U4 = 0x09,
+		MRK_TYPE_I8 = 0x0a,
+		MRK_TYPE_U8 = 0x0b,
+		MRK_TYPE_R4 = 0x0c,
+		MRK_TYPE_R8 = 0x0d,
+		MRK_TYPE_STRING = 0x0e,
+		MRK_TYPE_PTR = 0x0f,
+		MRK_TYPE_BYREF = 0x10,
+		MRK_TYPE_VALUETYPE = 0x11,
+		MRK_TYPE_CLASS = 0x12,
+		MRK_TYPE_VAR = 0x13,
+		MRK_TYPE_ARRAY = 0x14,
+		MRK_TYPE_GENERICINST = 0x15,
+		MRK_TYPE_I = 0x18,
+		MRK_TYPE_U = 0x19,
+		MRK_TYPE_OBJECT = 0x1c,
+		MRK_TYPE_SZARRAY = 0x1d,
+		MRK_TYPE_MVAR = 0x1e
+	};
+
+	struct MRKXCPPValueField {
+		char* Name;
+		mrku32 Kind;
+		mrku32 Offset; //from the start of the unboxed value
+	};
+
+	struct MRKXCPPType {
+		char* Name;
+		mrku32 Kind;
+		mrku32 Size; //unboxed size, value types only
+		mrku32 FieldCount;
+		MRKXCPPValueField* Fields; //instance fields, value types only
+		MRKXCPPType* Element; //single dimensional arrays only
+	};
+
 	struct MRKXCPPImage {
 		void* Ptr;
 		char* Name;
+		char* Mvid; //module version id, tokens are only valid against the exact same build
 	};
 
 	struct MRKXCPPClass {
@@ -37,6 +83,11 @@ namespace MRK {
 		MRKXCPPImage* Image;
 		char* Namespace;
 		char* Name;
+		MRKXCPPType Type;
+		char* GenericParams; //"TKey,TValue" for generic definitions, 0 otherwise
+		mrku32 Token;
+		bool Delegate; //derives from System.MulticastDelegate
+		char* Parents; //"UnityEngine.Component,UnityEngine.Object,System.Object", nearest first, 0 without a base
 	};
 
 	struct MRKXCPPMethod {
@@ -44,13 +95,34 @@ namespace MRK {
 		MRKXCPPClass* Class;
 		char* Name;
 		mrku32 ParamCount;
-		char** Params;
+		char** Params; //interned, see MRKXCPPInternName
 		int Occurance;
+		MRKXCPPType ReturnType;
+		mrku32 Token;
+		char* GenericParams; //"T" for generic method definitions, 0 otherwise
+		MRKXCPPType* ParamTypes; //parallel to Params
+		bool ICall; //implemented by the runtime itself (MethodImplOptions.InternalCall)
+		const char* DeclaringClass; //"Namespace.Name", interned, a base of Class for inherited methods
+		bool Virtual; //can be overridden, sealed overrides are not
+		char* BackingField; //the instance field a trivial getter (no params) or setter (one param) loads or stores, 0 otherwise
 	};
 
 	struct MRKXCPPField {
 		void* Ptr;
 		MRKXCPPClass* Class;
 		char* Name;
+		bool Static; //has storage in the class' static data, constants excluded
+		MRKXCPPType Type;
+		mrku32 Token;
+	};
+
+	//transient view used while enumerating an image, strings are owned by the runtime
+	struct MRKXCPPMemberInfo {
+		const char* Namespace;
+		const char* Name;
+		mrku32 ParamCount;
+		mrku32 GenericArity; //generic methods only
+		bool Static;
+		bool Public;
 	};
 }
\ No newline at end of file